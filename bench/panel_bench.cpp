@@ -0,0 +1,130 @@
+// Host benchmark of the framebuffer raster code (src/EInkPanel.h) for the 4.2"
+// panel, plus other sizes for comparison (raster cost only, the firmware is
+// built for 4.2"). Checks the span and sprite paths against setPixel first.
+//
+//   g++ -O2 -std=gnu++11 -I../src panel_bench.cpp -o panel_bench && ./panel_bench
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "EInkPanel.h"
+
+typedef EInkPanel<128, 296, 2> Raster290;
+typedef EInkPanel<800, 480, 2> Raster750;
+
+// 32x32 ring with a red centre, stands in for a weather icon
+static uint8_t spriteBlack[32 * 4];
+static uint8_t spriteRed[32 * 4];
+static const EInkSprite SPRITE = {32, 32, spriteBlack, spriteRed};
+
+static void makeSprite()
+{
+    for (int y = 0; y < 32; y++)
+        for (int x = 0; x < 32; x++)
+        {
+            int d = (x - 16) * (x - 16) + (y - 16) * (y - 16);
+            uint8_t bit = 0x80 >> (x & 7);
+            if (d >= 121 && d < 225)
+                spriteBlack[y * 4 + x / 8] |= bit;
+            else if (d < 36)
+                spriteRed[y * 4 + x / 8] |= bit;
+        }
+}
+
+template <class Panel>
+struct Planes
+{
+    std::vector<uint8_t> black, red;
+    Planes() : black(Panel::planeBytes), red(Panel::planeBytes) {}
+};
+
+template <class Panel>
+static bool verify()
+{
+    Planes<Panel> fast, ref;
+    Panel::clear(fast.black.data(), fast.red.data());
+    Panel::clear(ref.black.data(), ref.red.data());
+    srand(1);
+    const uint16_t colors[] = {EINK_BLACK, EINK_WHITE, EINK_RED};
+    for (int i = 0; i < 2000; i++)
+    {
+        int16_t x = rand() % (Panel::width + 40) - 20;
+        int16_t y = rand() % Panel::height;
+        int16_t w = rand() % 120;
+        uint16_t c = colors[rand() % 3];
+        Panel::fillSpan(fast.black.data(), fast.red.data(), x, y, w, c);
+        for (int16_t px = x; px < x + w; px++)
+            Panel::setPixel(ref.black.data(), ref.red.data(), px, y, c);
+    }
+    for (int i = 0; i < 200; i++)
+    {
+        int16_t x = rand() % (Panel::width + 32) - 32;
+        int16_t y = rand() % (Panel::height + 32) - 32;
+        Panel::drawSprite(fast.black.data(), fast.red.data(), x, y, SPRITE);
+        for (int sy = 0; sy < 32; sy++)
+            for (int sx = 0; sx < 32; sx++)
+            {
+                uint8_t bit = 0x80 >> (sx & 7);
+                if (spriteRed[sy * 4 + sx / 8] & bit)
+                    Panel::setPixel(ref.black.data(), ref.red.data(), x + sx, y + sy, EINK_RED);
+                else if (spriteBlack[sy * 4 + sx / 8] & bit)
+                    Panel::setPixel(ref.black.data(), ref.red.data(), x + sx, y + sy, EINK_BLACK);
+            }
+    }
+    return fast.black == ref.black && fast.red == ref.red;
+}
+
+template <class F>
+static double nsPerOp(int iterations, F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+        f(i);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+template <class Panel>
+static bool bench(const char *name)
+{
+    if (!verify<Panel>())
+    {
+        printf("%-5s MISMATCH between the span/sprite and the pixel path\n", name);
+        return false;
+    }
+
+    Planes<Panel> p;
+    uint8_t *black = p.black.data();
+    uint8_t *red = p.red.data();
+    volatile bool sink = false;
+
+    double clear = nsPerOp(2000, [&](int) { Panel::clear(black, red); });
+    double fill = nsPerOp(200, [&](int) {
+        for (int16_t y = 0; y < Panel::height; y++)
+            Panel::fillSpan(black, red, 0, y, Panel::width, EINK_BLACK);
+    });
+    double pixels = nsPerOp(20, [&](int) {
+        for (int16_t y = 0; y < Panel::height; y++)
+            for (int16_t x = 0; x < Panel::width; x++)
+                Panel::setPixel(black, red, x, y, EINK_BLACK);
+    });
+    double sprite = nsPerOp(200000, [&](int i) {
+        sink = Panel::drawSprite(black, red, (i * 37) % Panel::width - 16, (i * 11) % Panel::height - 16, SPRITE);
+    });
+    Panel::clear(black, red);
+    double scan = nsPerOp(2000, [&](int) { sink = Panel::hasRed(red); });
+    (void)sink;
+
+    printf("%-5s %4dx%-4d %6u B/plane  clear %8.0f ns  fill %9.0f ns  pixels %10.0f ns  sprite %5.0f ns  scan %7.0f ns\n",
+           name, Panel::width, Panel::height, (unsigned)Panel::planeBytes, clear, fill, pixels, sprite, scan);
+    return true;
+}
+
+int main()
+{
+    makeSprite();
+    bool ok = bench<Raster290>("2.9\"");
+    ok &= bench<EInkPanel420>("4.2\"");
+    ok &= bench<Raster750>("7.5\"");
+    return ok ? 0 : 1;
+}
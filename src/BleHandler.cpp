@@ -1,9 +1,9 @@
 #include "BleHandler.h"
-#include <BLEDevice.h>
-#include <BLEServer.h>
-#include <BLEUtils.h>
-#include <BLE2902.h>
+#include <NimBLEDevice.h>
 #include "Settings.h"
+#include "Telemetry.h"
+#include <esp_rom_crc.h>
+#include <esp_pm.h>
 
 // UUIDs
 #define SERVICE_UUID        "91bad492-b950-4226-aa2b-4ed124237670"
@@ -13,33 +13,204 @@
 #define CHAR_REFRESH_UUID   "91bad492-b950-4226-aa2b-4ed124237674"
 #define CHAR_ACTION_UUID    "91bad492-b950-4226-aa2b-4ed124237675"
 #define CHAR_QR_ENABLE_UUID "91bad492-b950-4226-aa2b-4ed124237676"
-#define CHAR_QR_BITMAP_UUID "91bad492-b950-4226-aa2b-4ed124237677"
-#define CHAR_QR_SIZE_UUID   "91bad492-b950-4226-aa2b-4ed124237678"
+// ...7677 / ...7678 were the QR bitmap upload (QR is now generated on the device)
+#define CHAR_DIAG_UUID      "91bad492-b950-4226-aa2b-4ed124237679"
+#define CHAR_BLOB_UUID      "91bad492-b950-4226-aa2b-4ed12423767a"
+#define CHAR_MODE_UUID      "91bad492-b950-4226-aa2b-4ed12423767b"
+#define CHAR_RENDER_URL_UUID "91bad492-b950-4226-aa2b-4ed12423767c"
+#define CHAR_CONFIG_TIMEOUT_UUID "91bad492-b950-4226-aa2b-4ed12423767d"
+#define CHAR_UPSTREAM_URL_UUID "91bad492-b950-4226-aa2b-4ed12423767e"
 
-BLEServer* pServer = NULL;
+// Advertising intervals (0.625 ms units): fast right after a gesture so the
+// phone finds the device at once, slow the rest of the time
+#define ADV_FAST_MIN 0x20   // 20 ms
+#define ADV_FAST_MAX 0x30   // 30 ms
+#define ADV_SLOW_MIN 0x640  // 1 s
+#define ADV_SLOW_MAX 0x780  // 1.2 s
+#define ADV_FAST_MS 30000
+
+// Diagnostics snapshot: header + the whole wake history
+#define DIAG_MAX_LEN TELEMETRY_MAX_LEN
+#define DIAG_NOTIFY_MS 2000
+
+// --- Settings blob (...767a) ---
+// Every write is one chunk: [u8 flags][u16 offset LE][data...]
+// The assembled blob is [u8 version][TLV: u8 tag, u8 len, value]...
+// On the LAST chunk it is parsed and applied atomically; the device then
+// notifies the status [u8 version][u8 status][u16 mtu LE][u32 crc32 LE].
+#define BLOB_VERSION    1
+#define BLOB_MAX_LEN    640
+#define BLOB_FLAG_FIRST 0x01 // Reset the assembly buffer
+#define BLOB_FLAG_LAST  0x02 // Apply after this chunk
+#define BLOB_FLAG_SAVE  0x04 // Save to NVS and reboot after applying
+
+enum BlobTag : uint8_t {
+    TAG_SSID = 1,
+    TAG_PASS = 2,
+    TAG_STATION = 3,
+    TAG_REFRESH_MIN = 4, // u16 LE
+    TAG_QR_ENABLED = 5,  // u8
+    // 6, 7: retired QR bitmap upload, skipped like unknown tags
+    TAG_DISPLAY_MODE = 8, // u8, DisplayMode
+    TAG_RENDER_URL = 9,   // Empty = thin client off
+    TAG_CONFIG_TIMEOUT = 10, // u8, minutes, 0 = never
+    TAG_UPSTREAM_URL = 11    // Empty = SBB API directly
+};
+
+enum BlobStatus : uint8_t {
+    BLOB_OK = 0,
+    BLOB_ERR_CHUNK,   // Out of order / too large
+    BLOB_ERR_FORMAT,  // Unknown version or truncated TLV
+    BLOB_ERR_VALUE    // Field out of range
+};
+
+NimBLEServer* pServer = NULL;
+NimBLECharacteristic* pDiag = NULL;
+NimBLECharacteristic* pBlob = NULL;
+unsigned long lastDiagNotify = 0;
 bool deviceConnected = false;
 bool oldDeviceConnected = false;
 bool shouldSave = false;
+bool fastAdvertising = false;
+unsigned long fastAdvertisingSince = 0;
+volatile unsigned long lastActivity = 0;
 
 // Buffer for Password (write-only)
 String newWifiPass = "";
 
-class MyServerCallbacks: public BLEServerCallbacks {
-    void onConnect(BLEServer* pServer) {
+uint8_t blobBuf[BLOB_MAX_LEN];
+size_t blobLen = 0;
+uint8_t blobStatus = BLOB_OK;
+uint32_t blobCrc = 0;
+
+static void setAdvertising(bool fast) {
+    NimBLEAdvertising *pAdvertising = NimBLEDevice::getAdvertising();
+    pAdvertising->stop();
+    pAdvertising->setMinInterval(fast ? ADV_FAST_MIN : ADV_SLOW_MIN);
+    pAdvertising->setMaxInterval(fast ? ADV_FAST_MAX : ADV_SLOW_MAX);
+    if (!deviceConnected) pAdvertising->start();
+    fastAdvertising = fast;
+    fastAdvertisingSince = millis();
+}
+
+// The idle task light-sleeps between BLE events (modem sleep keeps the link).
+// Needs power management and tickless idle in the sdkconfig, otherwise a no-op.
+static void enableLightSleep() {
+#if CONFIG_PM_ENABLE
+    esp_pm_config_esp32s3_t pm = {};
+    pm.max_freq_mhz = getCpuFrequencyMhz();
+    pm.min_freq_mhz = 40;
+    pm.light_sleep_enable = true;
+    esp_err_t err = esp_pm_configure(&pm);
+    Serial.printf("BLE light sleep: %s\n", esp_err_to_name(err));
+#endif
+}
+
+static uint16_t peerMtu() {
+    if (!pServer || pServer->getConnectedCount() == 0) return 23;
+    return pServer->getPeerMTU(pServer->getPeerDevices()[0]);
+}
+
+static void setBlobStatus(uint8_t status) {
+    blobStatus = status;
+    uint16_t mtu = peerMtu();
+    uint8_t out[8] = {
+        BLOB_VERSION, status,
+        (uint8_t)mtu, (uint8_t)(mtu >> 8),
+        (uint8_t)blobCrc, (uint8_t)(blobCrc >> 8), (uint8_t)(blobCrc >> 16), (uint8_t)(blobCrc >> 24)
+    };
+    pBlob->setValue(out, sizeof(out));
+}
+
+// Parse into locals first so a bad blob leaves the settings untouched
+static uint8_t applyBlob(const uint8_t *data, size_t len) {
+    if (len < 1 || data[0] != BLOB_VERSION) return BLOB_ERR_FORMAT;
+
+    String ssid = WIFI_SSID;
+    String pass = newWifiPass;
+    String station = STATION_NAME;
+    long refreshMs = REFRESH_MS;
+    bool qrEnabled = WLAN_QR_ENABLED;
+    DisplayMode mode = DISPLAY_MODE;
+    String renderUrl = RENDER_URL;
+    uint8_t configTimeout = CONFIG_TIMEOUT_MIN;
+    String upstreamUrl = UPSTREAM_URL;
+
+    size_t pos = 1;
+    while (pos < len) {
+        if (pos + 2 > len) return BLOB_ERR_FORMAT;
+        uint8_t tag = data[pos];
+        uint8_t fieldLen = data[pos + 1];
+        const uint8_t *v = data + pos + 2;
+        pos += 2 + fieldLen;
+        if (pos > len) return BLOB_ERR_FORMAT;
+
+        switch (tag) {
+            case TAG_SSID:    ssid = String((const char *)v, fieldLen); break;
+            case TAG_PASS:    pass = String((const char *)v, fieldLen); break;
+            case TAG_STATION: station = String((const char *)v, fieldLen); break;
+            case TAG_REFRESH_MIN: {
+                if (fieldLen != 2) return BLOB_ERR_FORMAT;
+                uint16_t minutes = v[0] | (v[1] << 8);
+                if (minutes == 0) return BLOB_ERR_VALUE;
+                refreshMs = minutes * 60 * 1000L;
+                break;
+            }
+            case TAG_QR_ENABLED:
+                if (fieldLen != 1) return BLOB_ERR_FORMAT;
+                qrEnabled = v[0] != 0;
+                break;
+            case TAG_DISPLAY_MODE:
+                if (fieldLen != 1) return BLOB_ERR_FORMAT;
+                if (v[0] > MODE_WATCHFACE) return BLOB_ERR_VALUE;
+                mode = (DisplayMode)v[0];
+                break;
+            case TAG_RENDER_URL:
+                renderUrl = String((const char *)v, fieldLen);
+                break;
+            case TAG_CONFIG_TIMEOUT:
+                if (fieldLen != 1) return BLOB_ERR_FORMAT;
+                configTimeout = v[0];
+                break;
+            case TAG_UPSTREAM_URL:
+                upstreamUrl = String((const char *)v, fieldLen);
+                break;
+            default:
+                break; // Unknown tags are skipped for forward compatibility
+        }
+    }
+    if (ssid.length() == 0 || station.length() == 0) return BLOB_ERR_VALUE;
+
+    WIFI_SSID = ssid;
+    newWifiPass = pass;
+    STATION_NAME = station;
+    REFRESH_MS = refreshMs;
+    WLAN_QR_ENABLED = qrEnabled;
+    DISPLAY_MODE = mode;
+    RENDER_URL = renderUrl;
+    CONFIG_TIMEOUT_MIN = configTimeout;
+    UPSTREAM_URL = upstreamUrl;
+    return BLOB_OK;
+}
+
+class MyServerCallbacks: public NimBLEServerCallbacks {
+    void onConnect(NimBLEServer* pServer) {
       deviceConnected = true;
+      lastActivity = millis();
       Serial.println("BLE Client Connected");
     };
 
-    void onDisconnect(BLEServer* pServer) {
+    void onDisconnect(NimBLEServer* pServer) {
       deviceConnected = false;
+      lastActivity = millis();
       Serial.println("BLE Client Disconnected");
       // Restart advertising
       pServer->getAdvertising()->start();
     }
 };
 
-class ActionCallback: public BLECharacteristicCallbacks {
-    void onWrite(BLECharacteristic *pCharacteristic) {
+class ActionCallback: public NimBLECharacteristicCallbacks {
+    void onWrite(NimBLECharacteristic *pCharacteristic) {
         std::string value = pCharacteristic->getValue(); // Get std::string
         String strVal = String(value.c_str());           // Convert to Arduino String
         
@@ -53,141 +224,292 @@ class ActionCallback: public BLECharacteristicCallbacks {
     }
 };
 
-class SettingsCallback: public BLECharacteristicCallbacks {
-    void onWrite(BLECharacteristic *pCharacteristic) {
+class DiagCallback: public NimBLECharacteristicCallbacks {
+    void onRead(NimBLECharacteristic *pCharacteristic) {
+        // Fresh snapshot on every read (heap stats are live)
+        uint8_t buf[DIAG_MAX_LEN];
+        size_t len = telemetry.serialize(buf, sizeof(buf));
+        pCharacteristic->setValue(buf, len);
+    }
+};
+
+enum SettingField {
+    FIELD_SSID,
+    FIELD_PASS,
+    FIELD_STATION,
+    FIELD_REFRESH,
+    FIELD_QR_ENABLE,
+    FIELD_DISPLAY_MODE,
+    FIELD_RENDER_URL,
+    FIELD_CONFIG_TIMEOUT,
+    FIELD_UPSTREAM_URL
+};
+
+class SettingsCallback: public NimBLECharacteristicCallbacks {
+public:
+    SettingsCallback(SettingField field) : _field(field) {}
+
+    void onWrite(NimBLECharacteristic *pCharacteristic) {
         std::string value = pCharacteristic->getValue();
         String strVal = String(value.c_str());
-        
-        BLEUUID uuid = pCharacteristic->getUUID();
-        
-        if (uuid.equals(BLEUUID(CHAR_SSID_UUID))) {
-             WIFI_SSID = strVal; // Update Global
-             Serial.println("New SSID: " + strVal);
-        }
-        else if (uuid.equals(BLEUUID(CHAR_PASS_UUID))) {
-             newWifiPass = strVal; // Buffer password
-             Serial.println("New Pass: Received");
-        }
-        else if (uuid.equals(BLEUUID(CHAR_STATION_UUID))) {
-             STATION_NAME = strVal;
-             Serial.println("New Station: " + strVal);
-        }
-        else if (uuid.equals(BLEUUID(CHAR_REFRESH_UUID))) {
-             int val = strVal.toInt();
-             if (val > 0) REFRESH_MS = val * 60 * 1000;
-             Serial.println("New Refresh: " + String(val));
-        }
-        else if (uuid.equals(BLEUUID(CHAR_QR_ENABLE_UUID))) {
-             WLAN_QR_ENABLED = (strVal == "1");
-             Serial.println("QR Enabled: " + strVal);
+
+        switch (_field) {
+            case FIELD_SSID:
+                WIFI_SSID = strVal; // Update Global
+                Serial.println("New SSID: " + strVal);
+                break;
+            case FIELD_PASS:
+                newWifiPass = strVal; // Buffer password
+                Serial.println("New Pass: Received");
+                break;
+            case FIELD_STATION:
+                STATION_NAME = strVal;
+                Serial.println("New Station: " + strVal);
+                break;
+            case FIELD_REFRESH: {
+                int val = strVal.toInt();
+                if (val > 0) REFRESH_MS = val * 60 * 1000;
+                Serial.println("New Refresh: " + String(val));
+                break;
+            }
+            case FIELD_QR_ENABLE:
+                WLAN_QR_ENABLED = (strVal == "1");
+                Serial.println("QR Enabled: " + strVal);
+                break;
+            case FIELD_DISPLAY_MODE:
+                DISPLAY_MODE = (strVal == "1") ? MODE_WATCHFACE : MODE_DEPARTURES;
+                Serial.println("Display Mode: " + strVal);
+                break;
+            case FIELD_RENDER_URL:
+                RENDER_URL = strVal;
+                Serial.println("Render URL: " + strVal);
+                break;
+            case FIELD_CONFIG_TIMEOUT: {
+                int val = strVal.toInt();
+                if (val >= 0 && val <= 255) CONFIG_TIMEOUT_MIN = val;
+                Serial.println("Config Timeout: " + String(val));
+                break;
+            }
+            case FIELD_UPSTREAM_URL:
+                UPSTREAM_URL = strVal;
+                Serial.println("Upstream URL: " + strVal);
+                break;
         }
-        else if (uuid.equals(BLEUUID(CHAR_QR_SIZE_UUID))) {
-             WLAN_QR_SIZE = strVal.toInt();
-             Serial.println("QR Size: " + strVal);
+    }
+
+private:
+    SettingField _field;
+};
+
+class BlobCallback: public NimBLECharacteristicCallbacks {
+    void onRead(NimBLECharacteristic *pCharacteristic) {
+        setBlobStatus(blobStatus); // Refresh MTU
+    }
+
+    void onWrite(NimBLECharacteristic *pCharacteristic) {
+        std::string value = pCharacteristic->getValue();
+        if (value.length() < 3) return;
+
+        const uint8_t *chunk = (const uint8_t *)value.data();
+        uint8_t flags = chunk[0];
+        size_t offset = chunk[1] | (chunk[2] << 8);
+        size_t len = value.length() - 3;
+
+        if (flags & BLOB_FLAG_FIRST) blobLen = 0;
+
+        // Chunks must arrive in order and fit the buffer
+        if (offset != blobLen || offset + len > BLOB_MAX_LEN) {
+            blobLen = 0;
+            setBlobStatus(BLOB_ERR_CHUNK);
+            pCharacteristic->notify();
+            return;
         }
-        else if (uuid.equals(BLEUUID(CHAR_QR_BITMAP_UUID))) {
-             // Bitmap is binary
-             if (value.length() <= 256) {
-                 memcpy(WLAN_QR_BITMAP, value.data(), value.length());
-                 Serial.print("Received QR Bitmap: ");
-                 Serial.print(value.length());
-                 Serial.println(" bytes");
-             }
+        memcpy(blobBuf + offset, chunk + 3, len);
+        blobLen += len;
+
+        if (!(flags & BLOB_FLAG_LAST)) return;
+
+        blobCrc = esp_rom_crc32_le(0, blobBuf, blobLen);
+        uint8_t status = applyBlob(blobBuf, blobLen);
+        Serial.printf("Settings blob: %u bytes, crc %08x, status %u\n", (unsigned)blobLen, (unsigned)blobCrc, status);
+        blobLen = 0;
+
+        setBlobStatus(status);
+        pCharacteristic->notify();
+
+        if (status == BLOB_OK && (flags & BLOB_FLAG_SAVE)) {
+            shouldSave = true;
         }
     }
 };
 
+// NimBLE does not take ownership of characteristic callbacks, so they are
+// allocated once here instead of with new on every begin()
+static MyServerCallbacks serverCallbacks;
+static ActionCallback actionCallback;
+static DiagCallback diagCallback;
+static BlobCallback blobCallback;
+static SettingsCallback settingsCallbacks[] = {
+    SettingsCallback(FIELD_SSID),
+    SettingsCallback(FIELD_PASS),
+    SettingsCallback(FIELD_STATION),
+    SettingsCallback(FIELD_REFRESH),
+    SettingsCallback(FIELD_QR_ENABLE),
+    SettingsCallback(FIELD_DISPLAY_MODE),
+    SettingsCallback(FIELD_RENDER_URL),
+    SettingsCallback(FIELD_CONFIG_TIMEOUT),
+    SettingsCallback(FIELD_UPSTREAM_URL)
+};
+
 void BleHandler::begin() {
-  BLEDevice::init("SBB_Display_Config");
+  uint32_t heapBefore = ESP.getFreeHeap();
+  NimBLEDevice::init("SBB_Display_Config");
+  NimBLEDevice::setMTU(517); // Let clients negotiate large chunks for the settings blob
   
-  // Security - Enable Bonding (Just Works)
-  BLESecurity *pSecurity = new BLESecurity();
-  pSecurity->setAuthenticationMode(ESP_LE_AUTH_REQ_SC_BOND);
-  pSecurity->setCapability(ESP_IO_CAP_NONE);
-  pSecurity->setInitEncryptionKey(ESP_BLE_ENC_KEY_MASK | ESP_BLE_ID_KEY_MASK);
+  // Security - Enable Bonding (Just Works, LE Secure Connections)
+  NimBLEDevice::setSecurityAuth(true, false, true);
+  NimBLEDevice::setSecurityIOCap(BLE_HS_IO_NO_INPUT_OUTPUT);
+  NimBLEDevice::setSecurityInitKey(BLE_SM_PAIR_KEY_DIST_ENC | BLE_SM_PAIR_KEY_DIST_ID);
 
-  pServer = BLEDevice::createServer();
-  pServer->setCallbacks(new MyServerCallbacks());
+  pServer = NimBLEDevice::createServer();
+  pServer->setCallbacks(&serverCallbacks, false);
 
-  BLEService *pService = pServer->createService(BLEUUID(SERVICE_UUID), 40, 0);
+  NimBLEService *pService = pServer->createService(SERVICE_UUID);
 
   // SSID
-  BLECharacteristic *pSsid = pService->createCharacteristic(
+  NimBLECharacteristic *pSsid = pService->createCharacteristic(
                                          CHAR_SSID_UUID,
-                                         BLECharacteristic::PROPERTY_READ |
-                                         BLECharacteristic::PROPERTY_WRITE
+                                         NIMBLE_PROPERTY::READ |
+                                         NIMBLE_PROPERTY::WRITE
                                        );
   pSsid->setValue(WIFI_SSID.c_str());
-  pSsid->setCallbacks(new SettingsCallback());
+  pSsid->setCallbacks(&settingsCallbacks[FIELD_SSID]);
 
   // Password (Write Only for security)
-  BLECharacteristic *pPass = pService->createCharacteristic(
+  NimBLECharacteristic *pPass = pService->createCharacteristic(
                                          CHAR_PASS_UUID,
-                                         BLECharacteristic::PROPERTY_WRITE
+                                         NIMBLE_PROPERTY::WRITE
                                        );
-  pPass->setCallbacks(new SettingsCallback());
+  pPass->setCallbacks(&settingsCallbacks[FIELD_PASS]);
 
   // Station
-  BLECharacteristic *pStation = pService->createCharacteristic(
+  NimBLECharacteristic *pStation = pService->createCharacteristic(
                                          CHAR_STATION_UUID,
-                                         BLECharacteristic::PROPERTY_READ |
-                                         BLECharacteristic::PROPERTY_WRITE
+                                         NIMBLE_PROPERTY::READ |
+                                         NIMBLE_PROPERTY::WRITE
                                        );
   pStation->setValue(STATION_NAME.c_str());
-  pStation->setCallbacks(new SettingsCallback());
+  pStation->setCallbacks(&settingsCallbacks[FIELD_STATION]);
 
   // Refresh (Minutes)
-  BLECharacteristic *pRefresh = pService->createCharacteristic(
+  NimBLECharacteristic *pRefresh = pService->createCharacteristic(
                                          CHAR_REFRESH_UUID,
-                                         BLECharacteristic::PROPERTY_READ |
-                                         BLECharacteristic::PROPERTY_WRITE
+                                         NIMBLE_PROPERTY::READ |
+                                         NIMBLE_PROPERTY::WRITE
                                        );
   pRefresh->setValue(String(REFRESH_MS / 60000).c_str());
-  pRefresh->setCallbacks(new SettingsCallback());
+  pRefresh->setCallbacks(&settingsCallbacks[FIELD_REFRESH]);
 
   // Action (Write "SAVE" to trigger save)
-  BLECharacteristic *pAction = pService->createCharacteristic(
+  NimBLECharacteristic *pAction = pService->createCharacteristic(
                                          CHAR_ACTION_UUID,
-                                         BLECharacteristic::PROPERTY_WRITE
+                                         NIMBLE_PROPERTY::WRITE
                                        );
-  pAction->setCallbacks(new ActionCallback());
+  pAction->setCallbacks(&actionCallback);
 
   // QR Enable
-  BLECharacteristic *pQrEnable = pService->createCharacteristic(
+  NimBLECharacteristic *pQrEnable = pService->createCharacteristic(
                                           CHAR_QR_ENABLE_UUID,
-                                          BLECharacteristic::PROPERTY_READ |
-                                          BLECharacteristic::PROPERTY_WRITE
+                                          NIMBLE_PROPERTY::READ |
+                                          NIMBLE_PROPERTY::WRITE
                                         );
   pQrEnable->setValue(WLAN_QR_ENABLED ? "1" : "0");
-  pQrEnable->setCallbacks(new SettingsCallback());
+  pQrEnable->setCallbacks(&settingsCallbacks[FIELD_QR_ENABLE]);
+
+  // Display Mode (0 = departures, 1 = watchface)
+  NimBLECharacteristic *pMode = pService->createCharacteristic(
+                                          CHAR_MODE_UUID,
+                                          NIMBLE_PROPERTY::READ |
+                                          NIMBLE_PROPERTY::WRITE
+                                        );
+  pMode->setValue(DISPLAY_MODE == MODE_WATCHFACE ? "1" : "0");
+  pMode->setCallbacks(&settingsCallbacks[FIELD_DISPLAY_MODE]);
+
+  // Render Server URL (thin client, empty = off)
+  NimBLECharacteristic *pRenderUrl = pService->createCharacteristic(
+                                          CHAR_RENDER_URL_UUID,
+                                          NIMBLE_PROPERTY::READ |
+                                          NIMBLE_PROPERTY::WRITE
+                                        );
+  pRenderUrl->setValue(RENDER_URL.c_str());
+  pRenderUrl->setCallbacks(&settingsCallbacks[FIELD_RENDER_URL]);
+
+  // Config mode idle timeout (minutes, 0 = never)
+  NimBLECharacteristic *pConfigTimeout = pService->createCharacteristic(
+                                          CHAR_CONFIG_TIMEOUT_UUID,
+                                          NIMBLE_PROPERTY::READ |
+                                          NIMBLE_PROPERTY::WRITE
+                                        );
+  pConfigTimeout->setValue(String(CONFIG_TIMEOUT_MIN).c_str());
+  pConfigTimeout->setCallbacks(&settingsCallbacks[FIELD_CONFIG_TIMEOUT]);
 
-  // QR Bitmap
-  BLECharacteristic *pQrBitmap = pService->createCharacteristic(
-                                          CHAR_QR_BITMAP_UUID,
-                                          BLECharacteristic::PROPERTY_READ |
-                                          BLECharacteristic::PROPERTY_WRITE
+  // LAN board cache (empty = SBB API directly)
+  NimBLECharacteristic *pUpstreamUrl = pService->createCharacteristic(
+                                          CHAR_UPSTREAM_URL_UUID,
+                                          NIMBLE_PROPERTY::READ |
+                                          NIMBLE_PROPERTY::WRITE
                                         );
-  pQrBitmap->setCallbacks(new SettingsCallback());
+  pUpstreamUrl->setValue(UPSTREAM_URL.c_str());
+  pUpstreamUrl->setCallbacks(&settingsCallbacks[FIELD_UPSTREAM_URL]);
 
-  // QR Size
-  BLECharacteristic *pQrSize = pService->createCharacteristic(
-                                          CHAR_QR_SIZE_UUID,
-                                          BLECharacteristic::PROPERTY_READ |
-                                          BLECharacteristic::PROPERTY_WRITE
+  // Diagnostics (Read / Notify)
+  pDiag = pService->createCharacteristic(
+                                          CHAR_DIAG_UUID,
+                                          NIMBLE_PROPERTY::READ |
+                                          NIMBLE_PROPERTY::NOTIFY
                                         );
-  pQrSize->setValue(String(WLAN_QR_SIZE).c_str());
-  pQrSize->setCallbacks(new SettingsCallback());
+  pDiag->setCallbacks(&diagCallback); // CCCD is added by NimBLE for NOTIFY
+
+  // Settings Blob (batched, chunked writes)
+  pBlob = pService->createCharacteristic(
+                                          CHAR_BLOB_UUID,
+                                          NIMBLE_PROPERTY::READ |
+                                          NIMBLE_PROPERTY::WRITE |
+                                          NIMBLE_PROPERTY::NOTIFY
+                                        );
+  pBlob->setCallbacks(&blobCallback);
+  setBlobStatus(BLOB_OK);
 
   pService->start();
 
-  BLEAdvertising *pAdvertising = BLEDevice::getAdvertising();
+  NimBLEAdvertising *pAdvertising = NimBLEDevice::getAdvertising();
   pAdvertising->addServiceUUID(SERVICE_UUID);
   pAdvertising->setScanResponse(true);
   pAdvertising->setMinPreferred(0x06);  
   pAdvertising->setMinPreferred(0x12);
-  BLEDevice::startAdvertising();
+  lastActivity = millis();
+  setAdvertising(true);
+  enableLightSleep();
   
-  Serial.println("BLE Service Started. Waiting for clients...");
+  Serial.printf("BLE Service Started, free heap %u -> %u. Waiting for clients...\n",
+                (unsigned)heapBefore, (unsigned)ESP.getFreeHeap());
+}
+
+void BleHandler::advertiseFast() {
+    lastActivity = millis(); // A button press counts as activity for the idle timeout
+    if (fastAdvertising) {
+        fastAdvertisingSince = millis(); // Extend the window
+        return;
+    }
+    setAdvertising(true);
+}
+
+bool BleHandler::isActive() const {
+    return fastAdvertising || deviceConnected;
+}
+
+unsigned long BleHandler::idleMs() const {
+    return deviceConnected ? 0 : millis() - lastActivity;
 }
 
 void BleHandler::saveAndReboot() {
@@ -197,10 +519,10 @@ void BleHandler::saveAndReboot() {
     // Note: For password, check if we received a new one
     String passToSave = (newWifiPass.length() > 0) ? newWifiPass : WIFI_PASS;
     
+    // The settings record is only rewritten if something changed
     saveSettings(WIFI_SSID, passToSave, STATION_NAME, (int)(REFRESH_MS/60000));
-    
-    // Also save the QR specific bits to NVS
-    saveWLANQR();
+    stop(); // Frees the host stack before the screens are baked
+    if (_savedCallback) _savedCallback();
 
     delay(1000);
     ESP.restart();
@@ -211,8 +533,33 @@ void BleHandler::update() {
         shouldSave = false;
         saveAndReboot();
     }
+
+    if (fastAdvertising && millis() - fastAdvertisingSince > ADV_FAST_MS) {
+        setAdvertising(false);
+    }
+
+    // Stream diagnostics to a connected client
+    if (deviceConnected && pDiag && millis() - lastDiagNotify > DIAG_NOTIFY_MS) {
+        lastDiagNotify = millis();
+        // Notifications are capped at MTU - 3 bytes
+        size_t maxLen = peerMtu() - 3;
+        if (maxLen > DIAG_MAX_LEN) maxLen = DIAG_MAX_LEN;
+        uint8_t buf[DIAG_MAX_LEN];
+        size_t len = telemetry.serialize(buf, maxLen);
+        pDiag->setValue(buf, len);
+        pDiag->notify();
+    }
 }
 
+// Tears down the host stack and releases all NimBLE objects
 void BleHandler::stop() {
-    BLEDevice::deinit(true);
+    if (!NimBLEDevice::getInitialized()) return;
+    uint32_t heapBefore = ESP.getFreeHeap();
+    NimBLEDevice::deinit(true);
+    pServer = NULL;
+    pDiag = NULL;
+    pBlob = NULL;
+    deviceConnected = false;
+    fastAdvertising = false;
+    Serial.printf("BLE stopped, free heap %u -> %u\n", (unsigned)heapBefore, (unsigned)ESP.getFreeHeap());
 }
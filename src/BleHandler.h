@@ -10,7 +10,17 @@ public:
     void saveAndReboot(); // Explicitly save and restart
     void stop();
 
+    // Fast advertising for ADV_FAST_MS (entering config mode, button press), slow otherwise
+    void advertiseFast();
+    bool isActive() const;        // Fast advertising or a client connected
+    unsigned long idleMs() const; // Since the last client left, 0 while one is connected
+
+    // Runs after the settings are written, before the restart
+    void onSaved(void (*callback)()) { _savedCallback = callback; }
+
 private:
+    void (*_savedCallback)() = nullptr;
+
     static void onConnect(bool success);
 };
 
@@ -0,0 +1,116 @@
+#include "ButtonInput.h"
+#include "UlpSupervisor.h"
+#include <esp_sleep.h>
+#include <esp_timer.h>
+
+ButtonInput button(PIN_TOUCH);
+
+ButtonInput::ButtonInput(int pin)
+    : _pin(pin), _held(false), _swallow(false), _edges(NULL), _events(NULL), _taskHandle(NULL)
+{
+}
+
+void ButtonInput::begin() {
+    pinMode(_pin, INPUT);
+    _edges = xQueueCreate(16, sizeof(Edge));
+    _events = xQueueCreate(8, sizeof(ButtonEvent));
+
+    // The ULP already decoded the gesture that woke us (call ulp.begin() first)
+    UlpEvent woke = ulp.wakeEvent();
+    if (woke == ULP_EVENT_SHORT) {
+        emit(BUTTON_PRESS);
+        emit(BUTTON_SHORT);
+    } else if (woke == ULP_EVENT_LONG) {
+        emit(BUTTON_LONG);
+    } else if (woke == ULP_EVENT_VERY_LONG) {
+        emit(BUTTON_VERY_LONG);
+        // Fired while held: the release of this press must not start a new gesture
+        _swallow = _held = digitalRead(_pin) == HIGH;
+    } else if (digitalRead(_pin) == HIGH) {
+        // Woken (or powered on) with the button down: the press started at boot at the latest
+        Edge edge = {0, HIGH};
+        xQueueSend(_edges, &edge, 0);
+    } else if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_EXT1) {
+        // Tap was already released before we got here
+        emit(BUTTON_SHORT);
+    }
+
+    xTaskCreatePinnedToCore(
+        ButtonInput::taskFunction,
+        "ButtonTask",
+        2048,
+        this,
+        2,
+        &_taskHandle,
+        0 // Core 0
+    );
+    attachInterruptArg(digitalPinToInterrupt(_pin), ButtonInput::onEdge, this, CHANGE);
+}
+
+bool ButtonInput::next(ButtonEvent &event, TickType_t wait) {
+    if (!_events) return false;
+    return xQueueReceive(_events, &event, wait) == pdTRUE;
+}
+
+void IRAM_ATTR ButtonInput::onEdge(void* arg) {
+    ButtonInput* b = (ButtonInput*)arg;
+    Edge edge = {esp_timer_get_time(), (uint8_t)digitalRead(b->_pin)};
+    BaseType_t woken = pdFALSE;
+    xQueueSendFromISR(b->_edges, &edge, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+void ButtonInput::taskFunction(void* parameter) {
+    ((ButtonInput*)parameter)->decode();
+}
+
+void ButtonInput::emit(ButtonEvent event) {
+    xQueueSend(_events, &event, 0); // Drop rather than block if nobody is listening
+}
+
+void ButtonInput::decode() {
+    bool pressed = _swallow;
+    bool veryLongSent = _swallow;
+    int64_t pressUs = 0;
+    int64_t releaseUs = -(int64_t)BUTTON_DEBOUNCE_MS * 1000; // The boot edge (t = 0) is a real press
+
+    while (true) {
+        // While held, wake up at the very-long threshold even without an edge
+        TickType_t wait = portMAX_DELAY;
+        if (pressed && !veryLongSent) {
+            int64_t heldMs = (esp_timer_get_time() - pressUs) / 1000;
+            wait = heldMs >= BUTTON_VERY_LONG_MS ? 0 : pdMS_TO_TICKS(BUTTON_VERY_LONG_MS - heldMs);
+        }
+
+        Edge edge;
+        if (xQueueReceive(_edges, &edge, wait) != pdTRUE) {
+            veryLongSent = true;
+            emit(BUTTON_VERY_LONG);
+            continue;
+        }
+
+        if (edge.level == HIGH) {
+            if (pressed) continue; // Bounce
+            if (edge.us - releaseUs < (int64_t)BUTTON_DEBOUNCE_MS * 1000) continue; // Release bounce
+            pressed = true;
+            veryLongSent = false;
+            pressUs = edge.us;
+            _held = true;
+            emit(BUTTON_PRESS);
+            continue;
+        }
+
+        if (!pressed) continue;
+        uint32_t heldMs = (edge.us - pressUs) / 1000;
+        if (heldMs <= BUTTON_DEBOUNCE_MS && digitalRead(_pin) == HIGH) continue; // Bounce
+
+        pressed = false;
+        _held = false;
+        releaseUs = edge.us;
+        if (veryLongSent) continue; // Already reported while held
+
+        if (heldMs > BUTTON_VERY_LONG_MS) emit(BUTTON_VERY_LONG);
+        else if (heldMs > BUTTON_LONG_MS) emit(BUTTON_LONG);
+        else if (heldMs > BUTTON_DEBOUNCE_MS) emit(BUTTON_SHORT);
+    }
+}
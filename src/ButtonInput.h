@@ -0,0 +1,50 @@
+#ifndef BUTTON_INPUT_H
+#define BUTTON_INPUT_H
+
+#include <Arduino.h>
+#include "Settings.h"
+
+// Gestures decoded from the raw edges
+enum ButtonEvent : uint8_t {
+    BUTTON_PRESS,       // Pressed down (for instant feedback, a gesture follows)
+    BUTTON_SHORT,       // Released after > BUTTON_DEBOUNCE_MS
+    BUTTON_LONG,        // Released after > BUTTON_LONG_MS
+    BUTTON_VERY_LONG    // Held for BUTTON_VERY_LONG_MS, fires while still held
+};
+
+const uint32_t BUTTON_DEBOUNCE_MS = 50;
+const uint32_t BUTTON_LONG_MS = 3000;
+const uint32_t BUTTON_VERY_LONG_MS = 8000;
+
+class ButtonInput {
+public:
+    ButtonInput(int pin);
+    void begin();   // Also picks up a press that woke the chip from deep sleep
+
+    // Next decoded gesture, waits up to `wait` ticks
+    bool next(ButtonEvent &event, TickType_t wait = 0);
+    // A gesture is in progress (pressed, not yet resolved)
+    bool isHeld() const { return _held; }
+
+private:
+    struct Edge {
+        int64_t us;     // esp_timer timestamp taken in the ISR
+        uint8_t level;
+    };
+
+    int _pin;
+    volatile bool _held;
+    bool _swallow;      // Press already reported by the ULP, ignore until released
+    QueueHandle_t _edges;
+    QueueHandle_t _events;
+    TaskHandle_t _taskHandle;
+
+    static void IRAM_ATTR onEdge(void* arg);
+    static void taskFunction(void* parameter);
+    void decode();
+    void emit(ButtonEvent event);
+};
+
+extern ButtonInput button;
+
+#endif
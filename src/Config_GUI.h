@@ -12,7 +12,7 @@
 #include <Fonts/FreeMono9pt7b.h>
 
 // Reference the global display object defined in main.cpp
-extern WeAct42_Driver display;
+extern DisplayDriver display;
 
 void drawConfigLine(const char *Label, const char *hint, const String &Value, int yPos)
 {
@@ -32,7 +32,7 @@ void drawConfigScreen()
     display.clearBuffer();
 
     // Header
-    display.fillRect(0, 0, 400, 45, EINK_RED);
+    display.fillRect(0, 0, EINK_WIDTH, 45, EINK_RED);
     display.setFont(&FreeMonoBold12pt7b);
     display.setTextColor(EINK_WHITE);
     display.setCursor(10, 35);
@@ -53,6 +53,8 @@ void drawConfigScreen()
     drawConfigLine("REFRESH", "7674", String(REFRESH_MS / 60000) + " min(s)", y);
     y += step;
     drawConfigLine("GUEST QR", "7676", WLAN_QR_ENABLED ? "ENABLED" : "DISABLED", y);
+    y += step;
+    drawConfigLine("MODE", "767b", DISPLAY_MODE == MODE_WATCHFACE ? "WATCHFACE" : "DEPARTURES", y);
     y += step * 1;
     display.setCursor(2, y);
     display.setTextColor(EINK_BLACK);
@@ -78,7 +80,7 @@ void drawConfigScreen()
     display.setTextColor(EINK_RED);
     display.setFont(&FreeMonoBold9pt7b);
     display.print("7675");
-    y += step * 2;
+    y += step;
     display.setCursor(2, y);
     display.setTextColor(EINK_BLACK);
     display.setFont(&FreeMono9pt7b);
@@ -0,0 +1,211 @@
+#include "DnsCache.h"
+#include <WiFiUdp.h>
+#include <time.h>
+#include "Telemetry.h"
+
+DnsCache dnsCache;
+
+struct DnsEntry {
+    char host[DNS_HOST_MAX];
+    uint32_t ip;
+    time_t expires;
+};
+
+// Survives deep sleep (lost on power cycle / reset)
+RTC_DATA_ATTR DnsEntry rtcDns[DNS_CACHE_SIZE];
+
+// Expired, or from before the clock was stepped back
+static bool fresh(const DnsEntry &e, time_t now) {
+    return e.host[0] && e.expires > now && e.expires - now <= (time_t)DNS_MAX_TTL_S;
+}
+
+static DnsEntry *find(const char *host) {
+    for (int i = 0; i < DNS_CACHE_SIZE; i++) {
+        if (strcmp(rtcDns[i].host, host) == 0) return &rtcDns[i];
+    }
+    return nullptr;
+}
+
+static void store(const char *host, IPAddress ip, uint32_t ttl) {
+    if (strlen(host) >= DNS_HOST_MAX) return;
+    time_t now = time(nullptr);
+    DnsEntry *slot = find(host);
+    for (int i = 0; !slot && i < DNS_CACHE_SIZE; i++) {
+        if (!fresh(rtcDns[i], now)) slot = &rtcDns[i];
+    }
+    if (!slot) { // Full: drop the one expiring first
+        slot = &rtcDns[0];
+        for (int i = 1; i < DNS_CACHE_SIZE; i++) {
+            if (rtcDns[i].expires < slot->expires) slot = &rtcDns[i];
+        }
+    }
+    strlcpy(slot->host, host, sizeof(slot->host));
+    slot->ip = (uint32_t)ip;
+    slot->expires = now + (ttl < DNS_MAX_TTL_S ? ttl : DNS_MAX_TTL_S);
+}
+
+bool DnsCache::resolve(const char *host, IPAddress &ip) {
+    DnsEntry *e = find(host);
+    if (e && fresh(*e, time(nullptr))) {
+        ip = IPAddress(e->ip);
+        return true;
+    }
+
+    telemetry.phaseStart(PHASE_DNS);
+    uint32_t ttl = 0;
+    bool ok = query(host, ip, ttl);
+    if (!ok) {
+        ok = WiFi.hostByName(host, ip) == 1;
+        ttl = DNS_FALLBACK_TTL_S;
+    }
+    telemetry.phaseEnd(PHASE_DNS);
+
+    if (!ok) return false;
+    Serial.printf("DNS: %s -> %s (TTL %lus)\n", host, ip.toString().c_str(), (unsigned long)ttl);
+    if (ttl > 0) store(host, ip, ttl);
+    return true;
+}
+
+void DnsCache::forget(const char *host) {
+    DnsEntry *e = find(host);
+    if (e) e->host[0] = 0;
+}
+
+// --- Wire format (RFC 1035) ---
+static uint8_t *put16(uint8_t *p, uint16_t v) { *p++ = v >> 8; *p++ = v; return p; }
+static uint16_t get16(const uint8_t *p) { return (p[0] << 8) | p[1]; }
+static uint32_t get32(const uint8_t *p) { return ((uint32_t)get16(p) << 16) | get16(p + 2); }
+
+// Offset past a (possibly compressed) name, 0 if it runs off the end
+static size_t skipName(const uint8_t *msg, size_t len, size_t at) {
+    while (at < len) {
+        uint8_t label = msg[at];
+        if (label == 0) return at + 1;
+        if ((label & 0xC0) == 0xC0) return at + 2 <= len ? at + 2 : 0;
+        at += label + 1;
+    }
+    return 0;
+}
+
+bool DnsCache::query(const char *host, IPAddress &ip, uint32_t &ttl) {
+    IPAddress server = WiFi.dnsIP();
+    size_t hostLen = strlen(host);
+    if ((uint32_t)server == 0 || hostLen == 0 || hostLen > 253) return false;
+
+    // Header: id, RD, one question
+    uint8_t msg[512];
+    uint16_t id = (uint16_t)esp_random();
+    uint8_t *p = put16(msg, id);
+    p = put16(p, 0x0100);
+    p = put16(p, 1);
+    memset(p, 0, 6);
+    p += 6;
+
+    // QNAME as labels, QTYPE A, QCLASS IN
+    const char *label = host;
+    while (*label) {
+        const char *dot = strchr(label, '.');
+        size_t n = dot ? dot - label : strlen(label);
+        if (n == 0 || n > 63) return false;
+        *p++ = n;
+        memcpy(p, label, n);
+        p += n;
+        label += n + (dot ? 1 : 0);
+    }
+    *p++ = 0;
+    p = put16(p, 1);
+    p = put16(p, 1);
+
+    WiFiUDP udp;
+    if (!udp.beginPacket(server, 53)) return false;
+    udp.write(msg, p - msg);
+    if (!udp.endPacket()) return false;
+
+    size_t len = 0;
+    unsigned long start = millis();
+    while (millis() - start < DNS_QUERY_TIMEOUT_MS) {
+        if (udp.parsePacket() > 0) {
+            len = udp.read(msg, sizeof(msg));
+            if (len >= 12 && get16(msg) == id) break;
+            len = 0; // Not ours
+        }
+        delay(5);
+    }
+    udp.stop();
+
+    // Response, no error, at least one answer
+    if (len < 12 || !(msg[2] & 0x80) || (msg[3] & 0x0F) != 0) return false;
+    uint16_t answers = get16(msg + 6);
+    size_t at = skipName(msg, len, 12);
+    if (at == 0 || at + 4 > len) return false;
+    at += 4;
+
+    // The first A record; a CNAME chain before it may only shorten the TTL
+    uint32_t minTtl = DNS_MAX_TTL_S;
+    for (uint16_t i = 0; i < answers; i++) {
+        at = skipName(msg, len, at);
+        if (at == 0 || at + 10 > len) return false;
+        uint16_t type = get16(msg + at);
+        uint16_t cls = get16(msg + at + 2);
+        uint32_t recordTtl = get32(msg + at + 4);
+        uint16_t rdLen = get16(msg + at + 8);
+        at += 10;
+        if (at + rdLen > len) return false;
+        if (recordTtl < minTtl) minTtl = recordTtl;
+        if (type == 1 && cls == 1 && rdLen == 4) {
+            ip = IPAddress(msg[at], msg[at + 1], msg[at + 2], msg[at + 3]);
+            ttl = minTtl;
+            return true;
+        }
+        at += rdLen;
+    }
+    return false;
+}
+
+// --- Connect by address ---
+// Host and port of an http(s) URL, false for IP literals (nothing to resolve)
+static bool parseUrl(const String &url, String &host, uint16_t &port) {
+    int start = url.indexOf("://");
+    if (start < 0) return false;
+    start += 3;
+    int end = start;
+    while (end < (int)url.length() && url[end] != '/' && url[end] != ':' && url[end] != '?') end++;
+    host = url.substring(start, end);
+    port = url.startsWith("https") ? 443 : 80;
+    if (end < (int)url.length() && url[end] == ':') port = url.substring(end + 1).toInt();
+
+    IPAddress literal;
+    return host.length() > 0 && port != 0 && !literal.fromString(host);
+}
+
+template <class Connect>
+static bool connectByAddress(const String &url, Connect connect) {
+    String host;
+    uint16_t port;
+    if (!parseUrl(url, host, port)) return false;
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        IPAddress ip;
+        if (!dnsCache.resolve(host.c_str(), ip)) return false;
+        telemetry.phaseStart(PHASE_FETCH);
+        bool ok = connect(ip, host, port);
+        telemetry.phaseEnd(PHASE_FETCH);
+        if (ok) return true;
+        Serial.printf("DNS: %s at %s did not answer, resolving again\n", host.c_str(), ip.toString().c_str());
+        dnsCache.forget(host.c_str());
+    }
+    return false;
+}
+
+bool DnsCache::connect(WiFiClient &client, const String &url) {
+    return connectByAddress(url, [&](IPAddress ip, const String &, uint16_t port) {
+        return client.connect(ip, port) == 1;
+    });
+}
+
+// The host name goes into the TLS handshake (SNI); certificates are not checked (setInsecure)
+bool DnsCache::connect(WiFiClientSecure &client, const String &url) {
+    return connectByAddress(url, [&](IPAddress ip, const String &host, uint16_t port) {
+        return client.connect(ip, port, host.c_str(), nullptr, nullptr, nullptr) == 1;
+    });
+}
@@ -0,0 +1,35 @@
+#ifndef DNS_CACHE_H
+#define DNS_CACHE_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiClientSecure.h>
+
+const uint8_t DNS_CACHE_SIZE = 4;
+const uint8_t DNS_HOST_MAX = 32;                      // Longer names are not cached
+const uint32_t DNS_FALLBACK_TTL_S = 5 * 60;           // System resolver, TTL unknown
+const uint32_t DNS_MAX_TTL_S = 24 * 60 * 60;
+const uint16_t DNS_QUERY_TIMEOUT_MS = 1500;
+
+// Resolved API hosts kept in RTC memory for their TTL, so a wake connects
+// without a DNS round trip. Lookups are timed as PHASE_DNS, the connect as PHASE_FETCH.
+class DnsCache {
+public:
+    // Address of `host`, from the cache while its TTL lasts
+    bool resolve(const char *host, IPAddress &ip);
+    void forget(const char *host); // The cached address did not answer
+
+    // Open the connection for `url` by address, before http.begin(client, url):
+    // HTTPClient reuses it and still sends the host name (and TLS its SNI).
+    // A failed connect resolves once more. False = leave it to HTTPClient.
+    bool connect(WiFiClient &client, const String &url);
+    bool connect(WiFiClientSecure &client, const String &url);
+
+private:
+    // One A query to the DHCP DNS server, unlike hostByName() it reports the TTL
+    static bool query(const char *host, IPAddress &ip, uint32_t &ttl);
+};
+
+extern DnsCache dnsCache;
+
+#endif
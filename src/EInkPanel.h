@@ -0,0 +1,200 @@
+#ifndef EINK_PANEL_H
+#define EINK_PANEL_H
+
+// Panel geometry and the framebuffer raster code, no hardware access.
+// Plain C++ so the same code runs in the host benchmark (bench/).
+#include <stdint.h>
+#include <string.h>
+
+// Standard Colors
+#define EINK_BLACK 0x0000
+#define EINK_WHITE 0xFFFF
+#define EINK_RED 0xF800
+
+// Screen area for partial updates
+struct EInkRect
+{
+    int16_t x, y, w, h;
+};
+
+// Two-plane 1-bpp sprite: rows padded to whole bytes, MSB first, bit set = ink.
+// Pixels set in neither plane are transparent. nullptr = empty plane.
+struct EInkSprite
+{
+    uint8_t w, h;
+    const uint8_t *black;
+    const uint8_t *red;
+};
+
+// Framebuffer layout, one bit per pixel and plane, rows padded to whole bytes:
+// Black plane: 0 = Ink (Black), 1 = Paper (White)
+// Red plane:   1 = Ink (Red),   0 = Paper (Transparent)
+// Single plane panels have no red plane (nullptr), red is drawn black there.
+// The raster functions return true if they put red ink into the red plane.
+template <int W, int H, int PLANES>
+struct EInkPanel
+{
+    static_assert(PLANES == 1 || PLANES == 2, "Black/white or black/white/red only");
+
+    static constexpr int width = W;
+    static constexpr int height = H;
+    static constexpr int planes = PLANES;
+    static constexpr int rowBytes = (W + 7) / 8;
+    static constexpr uint32_t planeBytes = (uint32_t)rowBytes * H;
+
+    static constexpr uint32_t byteIndex(int x, int y) { return (uint32_t)y * rowBytes + x / 8; }
+    static constexpr uint8_t bitMask(int x) { return 0x80 >> (x & 7); }
+
+    // Red ink on a black/white panel is drawn black
+    static constexpr bool inksBlack(uint16_t color) { return color == EINK_BLACK || (PLANES == 1 && color == EINK_RED); }
+    static constexpr bool inksRed(uint16_t color) { return PLANES == 2 && color == EINK_RED; }
+
+    // Clear to White: Black=1, Red=0
+    static void clear(uint8_t *black, uint8_t *red)
+    {
+        memset(black, 0xFF, planeBytes);
+        if (PLANES == 2)
+            memset(red, 0x00, planeBytes);
+    }
+
+    static bool setPixel(uint8_t *black, uint8_t *red, int16_t x, int16_t y, uint16_t color)
+    {
+        if (x < 0 || x >= W || y < 0 || y >= H)
+            return false;
+        uint32_t idx = byteIndex(x, y);
+        uint8_t mask = bitMask(x);
+
+        // Red: Black must be "White" (1) for Red to show
+        if (inksBlack(color))
+            black[idx] &= ~mask;
+        else
+            black[idx] |= mask;
+        if (PLANES == 2)
+        {
+            if (inksRed(color))
+                red[idx] |= mask;
+            else
+                red[idx] &= ~mask;
+        }
+        return inksRed(color);
+    }
+
+    // Horizontal span straight into the planes: edge bytes masked, the rest memset
+    static bool fillSpan(uint8_t *black, uint8_t *red, int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+        if (y < 0 || y >= H)
+            return false;
+        if (x < 0)
+        {
+            w += x;
+            x = 0;
+        }
+        if (x + w > W)
+            w = W - x;
+        if (w <= 0)
+            return false;
+
+        uint8_t blackVal = inksBlack(color) ? 0x00 : 0xFF;
+        uint8_t redVal = inksRed(color) ? 0xFF : 0x00;
+        black += (uint32_t)y * rowBytes;
+        if (PLANES == 2)
+            red += (uint32_t)y * rowBytes;
+
+        int16_t first = x / 8;
+        int16_t last = (x + w - 1) / 8;
+        uint8_t firstMask = 0xFF >> (x % 8);
+        uint8_t lastMask = 0xFF << (7 - (x + w - 1) % 8);
+        if (first == last)
+            firstMask &= lastMask;
+
+        black[first] = (black[first] & ~firstMask) | (blackVal & firstMask);
+        if (PLANES == 2)
+            red[first] = (red[first] & ~firstMask) | (redVal & firstMask);
+        if (first == last)
+            return redVal != 0;
+        if (last - first > 1)
+        {
+            memset(black + first + 1, blackVal, last - first - 1);
+            if (PLANES == 2)
+                memset(red + first + 1, redVal, last - first - 1);
+        }
+        black[last] = (black[last] & ~lastMask) | (blackVal & lastMask);
+        if (PLANES == 2)
+            red[last] = (red[last] & ~lastMask) | (redVal & lastMask);
+        return redVal != 0;
+    }
+
+    // Masked blit: every sprite byte lands in (at most) two buffer bytes
+    static bool drawSprite(uint8_t *black, uint8_t *red, int16_t x, int16_t y, const EInkSprite &s)
+    {
+        const int spriteRowBytes = (s.w + 7) / 8;
+        const int16_t firstCol = x >> 3; // Floor, also for negative x
+        const uint8_t shift = x & 7;
+        bool anyRed = false;
+
+        for (int16_t row = 0; row < s.h; row++)
+        {
+            int16_t py = y + row;
+            if (py < 0 || py >= H)
+                continue;
+            uint8_t *blackRow = black + (uint32_t)py * rowBytes;
+            uint8_t *redRow = PLANES == 2 ? red + (uint32_t)py * rowBytes : nullptr;
+
+            for (int b = 0; b < spriteRowBytes; b++)
+            {
+                uint8_t inkBlack = s.black ? s.black[row * spriteRowBytes + b] : 0;
+                uint8_t inkRed = s.red ? s.red[row * spriteRowBytes + b] : 0;
+                if (!(inkBlack | inkRed))
+                    continue;
+                if (PLANES == 1)
+                {
+                    inkBlack |= inkRed;
+                    inkRed = 0;
+                }
+                anyRed |= inkRed != 0;
+
+                uint16_t wideBlack = (uint16_t)inkBlack << (8 - shift);
+                uint16_t wideRed = (uint16_t)inkRed << (8 - shift);
+                for (int half = 0; half < 2; half++)
+                {
+                    int16_t col = firstCol + b + half;
+                    uint8_t mb = half ? wideBlack & 0xFF : wideBlack >> 8;
+                    uint8_t mr = half ? wideRed & 0xFF : wideRed >> 8;
+                    if (col < 0 || col >= rowBytes || !(mb | mr))
+                        continue;
+                    // Black ink: black 0, red 0. Red ink: black 1, red 1 (see setPixel)
+                    blackRow[col] = (blackRow[col] & ~mb) | mr;
+                    if (PLANES == 2)
+                        redRow[col] = (redRow[col] & ~(mb | mr)) | mr;
+                }
+            }
+        }
+        return anyRed;
+    }
+
+    // For planes filled directly instead of drawn
+    static bool hasRed(const uint8_t *red)
+    {
+        if (PLANES == 1)
+            return false;
+        const uint32_t *words = (const uint32_t *)red;
+        uint32_t any = 0;
+        for (uint32_t i = 0; i < planeBytes / 4; i++)
+            any |= words[i];
+        for (uint32_t i = planeBytes & ~3u; i < planeBytes; i++)
+            any |= red[i];
+        return any != 0;
+    }
+};
+
+// Out-of-class definitions, needed when a member is bound to a reference (C++11)
+template <int W, int H, int P> constexpr int EInkPanel<W, H, P>::width;
+template <int W, int H, int P> constexpr int EInkPanel<W, H, P>::height;
+template <int W, int H, int P> constexpr int EInkPanel<W, H, P>::planes;
+template <int W, int H, int P> constexpr int EInkPanel<W, H, P>::rowBytes;
+template <int W, int H, int P> constexpr uint32_t EInkPanel<W, H, P>::planeBytes;
+
+// The supported module, in the controller's native orientation
+typedef EInkPanel<400, 300, 2> EInkPanel420; // 4.2" WeAct B/W/R (SSD1683)
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#include <Arduino.h>
+
+// PackBits run-length coding, applied to one framebuffer plane at a time.
+// Control byte n:   0..127 -> n + 1 literal bytes follow
+//                 129..255 -> the next byte repeats 257 - n times
+//                      128 -> no-op
+// Mostly-white planes shrink to a few hundred bytes.
+
+// Worst case encoded size (all literals)
+#define PACKBITS_MAX_LEN(len) ((len) + ((len) + 127) / 128)
+
+// --- Frame header (little-endian) ---
+// Shared by thin client responses (RenderClient.h) and the flash frame store (FrameStore.h).
+// Planes use the driver layout (black: 0 = ink, red: 1 = ink).
+struct __attribute__((packed)) FrameHeader
+{
+    char magic[4]; // "EFRM"
+    uint8_t version;
+    uint8_t encoding; // FrameEncoding
+    uint16_t width;
+    uint16_t height;
+    uint16_t reserved;
+    uint32_t hash;     // CRC32 of the raw black + red planes
+    uint32_t blackLen; // Encoded sizes
+    uint32_t redLen;
+};
+
+const uint8_t FRAME_VERSION = 1;
+
+enum FrameEncoding : uint8_t
+{
+    FRAME_RAW = 0,
+    FRAME_PACKBITS = 1
+};
+
+// Encode in[inLen] into out, returns the encoded length (0 if outMax is too small)
+inline size_t packBits(const uint8_t *in, size_t inLen, uint8_t *out, size_t outMax)
+{
+    size_t pos = 0, i = 0;
+    while (i < inLen)
+    {
+        size_t run = 1;
+        while (i + run < inLen && run < 128 && in[i + run] == in[i])
+            run++;
+        if (run >= 2)
+        {
+            if (pos + 2 > outMax)
+                return 0;
+            out[pos++] = (uint8_t)(257 - run);
+            out[pos++] = in[i];
+            i += run;
+            continue;
+        }
+
+        // Literals until the next run of 3+ (a run of 2 is not worth breaking for)
+        size_t start = i;
+        while (i < inLen && i - start < 128)
+        {
+            if (i + 2 < inLen && in[i] == in[i + 1] && in[i] == in[i + 2])
+                break;
+            i++;
+        }
+        size_t count = i - start;
+        if (pos + 1 + count > outMax)
+            return 0;
+        out[pos++] = (uint8_t)(count - 1);
+        memcpy(out + pos, in + start, count);
+        pos += count;
+    }
+    return pos;
+}
+
+// Decode from memory (e.g. memory-mapped flash), same rules as the stream version
+inline bool unpackBits(const uint8_t *in, size_t inLen, uint8_t *out, size_t outLen)
+{
+    size_t pos = 0, i = 0;
+    while (i < inLen)
+    {
+        uint8_t ctrl = in[i++];
+        if (ctrl < 128)
+        {
+            size_t count = ctrl + 1;
+            if (i + count > inLen || pos + count > outLen)
+                return false;
+            memcpy(out + pos, in + i, count);
+            pos += count;
+            i += count;
+        }
+        else if (ctrl > 128)
+        {
+            size_t count = 257 - ctrl;
+            if (i >= inLen || pos + count > outLen)
+                return false;
+            memset(out + pos, in[i++], count);
+            pos += count;
+        }
+    }
+    return pos == outLen;
+}
+
+// Streaming decode: consumes exactly inLen bytes from `in` (e.g. an HTTP body)
+// and fills out[outLen]. False on a short read or if the sizes do not add up.
+inline bool unpackBits(Stream &in, size_t inLen, uint8_t *out, size_t outLen)
+{
+    size_t pos = 0;
+    uint8_t ctrl, value;
+    while (inLen > 0)
+    {
+        if (in.readBytes(&ctrl, 1) != 1)
+            return false;
+        inLen--;
+
+        if (ctrl < 128)
+        {
+            size_t count = ctrl + 1;
+            if (count > inLen || pos + count > outLen || in.readBytes(out + pos, count) != count)
+                return false;
+            pos += count;
+            inLen -= count;
+        }
+        else if (ctrl > 128)
+        {
+            size_t count = 257 - ctrl;
+            if (inLen < 1 || pos + count > outLen || in.readBytes(&value, 1) != 1)
+                return false;
+            memset(out + pos, value, count);
+            pos += count;
+            inLen--;
+        }
+    }
+    return pos == outLen;
+}
+
+#endif
@@ -0,0 +1,104 @@
+#include "FrameStore.h"
+#include "FrameCodec.h"
+#include "WeAct_EInk.h"
+#include <esp_ota_ops.h>
+#include <esp_rom_crc.h>
+
+FrameStore frameStore;
+
+// --- Slot layout ---
+// SlotHeader, FrameHeader, black plane, red plane (PackBits).
+// The header is written last, so an interrupted write never looks valid.
+struct __attribute__((packed)) SlotHeader {
+    uint32_t key;
+    uint32_t build;
+};
+
+const size_t PLANE_LEN = PanelGeometry::planeBytes;
+const size_t HEADERS_LEN = sizeof(SlotHeader) + sizeof(FrameHeader);
+
+// Two worst-case PackBits planes, rounded up to the 4 KB erase sector.
+// 32 KB on the 4.2" panel.
+const size_t FRAME_SLOT_SIZE = (HEADERS_LEN + 2 * PACKBITS_MAX_LEN(PLANE_LEN) + 0xFFF) & ~(size_t)0xFFF;
+
+bool FrameStore::begin() {
+    _partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                          (esp_partition_subtype_t)FRAME_PARTITION_SUBTYPE, "frames");
+    if (!_partition) {
+        Serial.println("FrameStore: no 'frames' partition");
+        return false;
+    }
+    if (_partition->size < FRAME_SLOT_COUNT * FRAME_SLOT_SIZE) {
+        Serial.println("FrameStore: partition too small");
+        _partition = nullptr;
+        return false;
+    }
+
+    const esp_app_desc_t *app = esp_ota_get_app_description();
+    memcpy(&_build, app->app_elf_sha256, sizeof(_build));
+    return true;
+}
+
+bool FrameStore::load(FrameSlot slot, uint32_t key, uint8_t *black, uint8_t *red) {
+    if (!_partition || slot >= FRAME_SLOT_COUNT) return false;
+
+    // Map the slot instead of copying it, the planes decode straight out of flash
+    const void *mapped;
+    spi_flash_mmap_handle_t handle;
+    if (esp_partition_mmap(_partition, slot * FRAME_SLOT_SIZE, FRAME_SLOT_SIZE,
+                           SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK) {
+        return false;
+    }
+
+    const uint8_t *p = (const uint8_t *)mapped;
+    SlotHeader slotHeader;
+    FrameHeader frame;
+    memcpy(&slotHeader, p, sizeof(slotHeader));
+    memcpy(&frame, p + sizeof(slotHeader), sizeof(frame));
+
+    bool ok = slotHeader.key == key && slotHeader.build == _build &&
+              memcmp(frame.magic, "EFRM", 4) == 0 && frame.version == FRAME_VERSION &&
+              frame.encoding == FRAME_PACKBITS && frame.width == EINK_WIDTH && frame.height == EINK_HEIGHT &&
+              HEADERS_LEN + frame.blackLen + frame.redLen <= FRAME_SLOT_SIZE;
+    ok = ok && unpackBits(p + HEADERS_LEN, frame.blackLen, black, PLANE_LEN) &&
+         unpackBits(p + HEADERS_LEN + frame.blackLen, frame.redLen, red, PLANE_LEN);
+    spi_flash_munmap(handle);
+
+    if (ok) {
+        uint32_t crc = esp_rom_crc32_le(0, black, PLANE_LEN);
+        ok = esp_rom_crc32_le(crc, red, PLANE_LEN) == frame.hash;
+    }
+    Serial.printf("FrameStore: slot %u %s\n", slot, ok ? "loaded" : "stale");
+    return ok;
+}
+
+bool FrameStore::store(FrameSlot slot, uint32_t key, const uint8_t *black, const uint8_t *red) {
+    if (!_partition || slot >= FRAME_SLOT_COUNT) return false;
+
+    const size_t maxLen = PACKBITS_MAX_LEN(PLANE_LEN);
+    uint8_t *packed = (uint8_t *)malloc(2 * maxLen);
+    if (!packed) return false;
+
+    FrameHeader frame;
+    memcpy(frame.magic, "EFRM", 4);
+    frame.version = FRAME_VERSION;
+    frame.encoding = FRAME_PACKBITS;
+    frame.width = EINK_WIDTH;
+    frame.height = EINK_HEIGHT;
+    frame.reserved = 0;
+    frame.hash = esp_rom_crc32_le(esp_rom_crc32_le(0, black, PLANE_LEN), red, PLANE_LEN);
+    frame.blackLen = packBits(black, PLANE_LEN, packed, maxLen);
+    frame.redLen = packBits(red, PLANE_LEN, packed + frame.blackLen, maxLen);
+
+    SlotHeader slotHeader = {key, _build};
+    size_t offset = slot * FRAME_SLOT_SIZE;
+    bool ok = esp_partition_erase_range(_partition, offset, FRAME_SLOT_SIZE) == ESP_OK &&
+              esp_partition_write(_partition, offset + HEADERS_LEN, packed, frame.blackLen + frame.redLen) == ESP_OK &&
+              esp_partition_write(_partition, offset + sizeof(slotHeader), &frame, sizeof(frame)) == ESP_OK &&
+              esp_partition_write(_partition, offset, &slotHeader, sizeof(slotHeader)) == ESP_OK;
+    free(packed);
+
+    Serial.printf("FrameStore: slot %u %s, %u bytes\n", slot, ok ? "baked" : "write failed",
+                  (unsigned)(frame.blackLen + frame.redLen));
+    return ok;
+}
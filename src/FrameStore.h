@@ -0,0 +1,34 @@
+#ifndef FRAME_STORE_H
+#define FRAME_STORE_H
+
+#include <Arduino.h>
+#include <esp_partition.h>
+
+// Pre-baked full screens kept in the "frames" flash partition (partitions_16MB.csv)
+enum FrameSlot : uint8_t {
+    FRAME_SLOT_CONFIG,  // drawConfigScreen()
+    FRAME_SLOT_QR,      // drawQRCodePage()
+    FRAME_SLOT_COUNT
+};
+
+const uint8_t FRAME_PARTITION_SUBTYPE = 0x40; // First custom data subtype
+
+class FrameStore {
+public:
+    bool begin();
+
+    // Decode a stored screen into the plane buffers. `key` identifies the content
+    // (e.g. the settings it was drawn from); false if missing, stale or corrupt.
+    bool load(FrameSlot slot, uint32_t key, uint8_t *black, uint8_t *red);
+
+    // Compress the plane buffers into a slot
+    bool store(FrameSlot slot, uint32_t key, const uint8_t *black, const uint8_t *red);
+
+private:
+    const esp_partition_t *_partition = nullptr;
+    uint32_t _build = 0; // Firmware identity, a new build re-bakes everything
+};
+
+extern FrameStore frameStore;
+
+#endif
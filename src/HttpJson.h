@@ -0,0 +1,38 @@
+#ifndef HTTP_JSON_H
+#define HTTP_JSON_H
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <ArduinoJson.h>
+#include "InflateStream.h"
+
+// Ask for a gzip body, call between http.begin() and http.GET().
+// HTTP/1.0 keeps the body unchunked so it can be read straight off the socket.
+// Retry-After is kept for the request budget (429 responses), Date for the wall clock.
+inline void requestCompressed(HTTPClient &http)
+{
+    static const char *headers[] = {"Content-Encoding", "Retry-After", "Date"};
+    http.useHTTP10(true);
+    http.addHeader("Accept-Encoding", "gzip");
+    http.collectHeaders(headers, 3);
+}
+
+// Parse the body of a successful GET, inflating it on the fly when it is gzip.
+// Only the 32 KB inflate window is buffered, never the whole document.
+inline DeserializationError deserializeResponse(HTTPClient &http, JsonDocument &doc, const char *label)
+{
+    bool gzip = http.header("Content-Encoding").equalsIgnoreCase("gzip");
+    InflateStream body;
+    if (!body.begin(*http.getStreamPtr(), http.getSize(), gzip))
+        return DeserializationError::NoMemory;
+
+    DeserializationError err = deserializeJson(doc, body);
+    if (!err && body.failed())
+        err = DeserializationError::InvalidInput;
+
+    Serial.printf("%s: %u bytes received, %u bytes JSON%s\n", label, (unsigned)body.wireBytes(),
+                  (unsigned)body.payloadBytes(), gzip ? " (gzip)" : "");
+    return err;
+}
+
+#endif
@@ -0,0 +1,212 @@
+#include "InflateStream.h"
+#include <rom/miniz.h>
+#include <esp_rom_crc.h>
+
+// gzip header flags (RFC 1952)
+const uint8_t GZIP_FHCRC = 0x02;
+const uint8_t GZIP_FEXTRA = 0x04;
+const uint8_t GZIP_FNAME = 0x08;
+const uint8_t GZIP_FCOMMENT = 0x10;
+
+bool InflateStream::begin(Stream &in, int length, bool gzip) {
+    end();
+    _in = &in;
+    _remaining = length;
+    _gzip = gzip;
+    _done = _failed = false;
+    _needInput = true;
+    _windowPos = _readPos = _readEnd = 0;
+    _inputPos = _inputLen = 0;
+    _carryPos = _carryLen = 0;
+    _crc = 0;
+    _wireBytes = _payloadBytes = 0;
+    if (!gzip) return true;
+
+    _inflator = (tinfl_decompressor *)malloc(sizeof(tinfl_decompressor));
+    _window = (uint8_t *)malloc(INFLATE_WINDOW);
+    if (!_inflator || !_window) {
+        end();
+        return false;
+    }
+    tinfl_init(_inflator);
+
+    if (!skipGzipHeader()) {
+        Serial.println("Inflate: not a gzip stream");
+        _failed = _done = true;
+    }
+    return true;
+}
+
+void InflateStream::end() {
+    free(_inflator);
+    free(_window);
+    _inflator = nullptr;
+    _window = nullptr;
+}
+
+// --- Socket side ---
+
+// Never asks for more than has arrived (or is left), so the last read does not sit in the timeout
+bool InflateStream::refillInput() {
+    if (_remaining == 0) return false;
+    size_t want = sizeof(_input);
+    size_t arrived = _in->available();
+    if (arrived > 0 && arrived < want) want = arrived;
+    else if (arrived == 0) want = 1;
+    if (_remaining > 0 && (size_t)_remaining < want) want = _remaining;
+
+    _inputLen = _in->readBytes(_input, want);
+    _inputPos = 0;
+    _wireBytes += _inputLen;
+    if (_remaining > 0) _remaining -= _inputLen;
+    return _inputLen > 0;
+}
+
+bool InflateStream::inputByte(uint8_t &b) {
+    if (_carryPos < _carryLen) {
+        b = _carry[_carryPos++];
+        return true;
+    }
+    if (_inputPos == _inputLen && !refillInput()) return false;
+    b = _input[_inputPos++];
+    return true;
+}
+
+bool InflateStream::skipGzipHeader() {
+    uint8_t h[10];
+    for (int i = 0; i < 10; i++) {
+        if (!inputByte(h[i])) return false;
+    }
+    if (h[0] != 0x1f || h[1] != 0x8b || h[2] != 8) return false; // Magic, CM = deflate
+
+    uint8_t b, lo, hi;
+    uint8_t flags = h[3];
+    if (flags & GZIP_FEXTRA) {
+        if (!inputByte(lo) || !inputByte(hi)) return false;
+        for (int n = lo | (hi << 8); n > 0; n--) {
+            if (!inputByte(b)) return false;
+        }
+    }
+    if (flags & GZIP_FNAME) {
+        do { if (!inputByte(b)) return false; } while (b != 0);
+    }
+    if (flags & GZIP_FCOMMENT) {
+        do { if (!inputByte(b)) return false; } while (b != 0);
+    }
+    if (flags & GZIP_FHCRC) {
+        if (!inputByte(b) || !inputByte(b)) return false;
+    }
+    return true;
+}
+
+// The ROM tinfl (miniz 1.x) reads input ahead into its bit buffer and keeps it at
+// TINFL_STATUS_DONE, so _inputPos is already past the start of the trailer.
+// Step back by the whole bytes still buffered and drop those bits (the rest is
+// padding of the last deflate byte). Bytes that came in before the last refill
+// are no longer in _input, they are taken from the bit buffer instead.
+void InflateStream::giveBackReadAhead() {
+    size_t held = _inflator->m_num_bits >> 3;
+    tinfl_bit_buf_t bits = _inflator->m_bit_buf >> (_inflator->m_num_bits & 7);
+    _inflator->m_num_bits = 0;
+    _inflator->m_bit_buf = 0;
+
+    if (held <= _inputPos) {
+        _inputPos -= held;
+        return;
+    }
+    _carryLen = held - _inputPos;
+    _carryPos = 0;
+    for (uint8_t i = 0; i < _carryLen; i++) _carry[i] = (uint8_t)(bits >> (8 * i));
+    _inputPos = 0;
+}
+
+// CRC32 + ISIZE of the uncompressed data
+bool InflateStream::checkGzipTrailer() {
+    uint8_t t[8];
+    for (int i = 0; i < 8; i++) {
+        if (!inputByte(t[i])) return false;
+    }
+    uint32_t crc = t[0] | (t[1] << 8) | (t[2] << 16) | ((uint32_t)t[3] << 24);
+    uint32_t size = t[4] | (t[5] << 8) | (t[6] << 16) | ((uint32_t)t[7] << 24);
+    return crc == _crc && size == (uint32_t)_payloadBytes;
+}
+
+// --- Inflate ---
+
+// Produces the next run of output into the window, false at the end of the stream
+bool InflateStream::inflateMore() {
+    while (!_done) {
+        if (_needInput && _inputPos == _inputLen && !refillInput()) {
+            _failed = _done = true; // Connection ended inside the deflate stream
+            break;
+        }
+
+        size_t inLen = _inputLen - _inputPos;
+        size_t outLen = INFLATE_WINDOW - _windowPos;
+        mz_uint32 flags = (_remaining != 0) ? TINFL_FLAG_HAS_MORE_INPUT : 0;
+        tinfl_status status = tinfl_decompress(_inflator, _input + _inputPos, &inLen,
+                                               _window, _window + _windowPos, &outLen, flags);
+        _inputPos += inLen;
+        _needInput = status == TINFL_STATUS_NEEDS_MORE_INPUT;
+
+        if (outLen > 0) {
+            _readPos = _windowPos;
+            _readEnd = _windowPos + outLen;
+            _windowPos = _readEnd & (INFLATE_WINDOW - 1);
+            _crc = esp_rom_crc32_le(_crc, _window + _readPos, outLen);
+            _payloadBytes += outLen;
+        }
+
+        if (status == TINFL_STATUS_DONE) {
+            _done = true;
+            giveBackReadAhead();
+            if (!checkGzipTrailer()) {
+                Serial.println("Inflate: gzip CRC/size mismatch");
+                _failed = true;
+            }
+        } else if (status < TINFL_STATUS_DONE) {
+            Serial.printf("Inflate: error %d\n", (int)status);
+            _failed = _done = true;
+        }
+
+        if (_readPos < _readEnd) return true;
+    }
+    return _readPos < _readEnd;
+}
+
+// --- Stream ---
+
+int InflateStream::available() {
+    if (!_gzip) return _in ? _in->available() : 0;
+    return (_readPos < _readEnd || inflateMore()) ? (int)(_readEnd - _readPos) : 0;
+}
+
+int InflateStream::peek() {
+    if (!_gzip) return _in ? _in->peek() : -1;
+    return available() ? _window[_readPos] : -1;
+}
+
+int InflateStream::read() {
+    char c;
+    return readBytes(&c, 1) == 1 ? (uint8_t)c : -1;
+}
+
+size_t InflateStream::readBytes(char *buffer, size_t length) {
+    if (!_in) return 0;
+    if (!_gzip) {
+        size_t n = _in->readBytes(buffer, length);
+        _wireBytes += n;
+        _payloadBytes += n;
+        return n;
+    }
+
+    size_t total = 0;
+    while (total < length && (_readPos < _readEnd || inflateMore())) {
+        size_t n = _readEnd - _readPos;
+        if (n > length - total) n = length - total;
+        memcpy(buffer + total, _window + _readPos, n);
+        _readPos += n;
+        total += n;
+    }
+    return total;
+}
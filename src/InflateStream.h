@@ -0,0 +1,63 @@
+#ifndef INFLATE_STREAM_H
+#define INFLATE_STREAM_H
+
+#include <Arduino.h>
+
+struct tinfl_decompressor_tag;
+
+// Deflate back-reference limit, the only output kept in RAM
+const size_t INFLATE_WINDOW = 32768;
+const size_t INFLATE_INPUT_LEN = 1024;
+
+// Read-only Stream that inflates a gzip body (ROM miniz) on the fly,
+// or passes a plain body through. Tracks wire vs. payload bytes.
+class InflateStream : public Stream {
+public:
+    ~InflateStream() { end(); }
+
+    // `length` is the Content-Length, -1 if unknown
+    bool begin(Stream &in, int length, bool gzip);
+    void end();
+
+    // Stream
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char *buffer, size_t length) override;
+    using Stream::readBytes;
+    size_t write(uint8_t) override { return 0; }
+
+    size_t wireBytes() const { return _wireBytes; }
+    size_t payloadBytes() const { return _payloadBytes; }
+    bool failed() const { return _failed; }   // Corrupt data or CRC/size mismatch
+
+private:
+    Stream *_in = nullptr;
+    int _remaining = -1;
+    bool _gzip = false;
+    bool _done = false;
+    bool _failed = false;
+    bool _needInput = true;         // Inflater consumed all input it was given
+
+    tinfl_decompressor_tag *_inflator = nullptr;
+    uint8_t *_window = nullptr;     // Wrapping output buffer
+    size_t _windowPos = 0;          // Next write position
+    size_t _readPos = 0, _readEnd = 0; // Inflated bytes not yet consumed
+    uint8_t _input[INFLATE_INPUT_LEN];
+    size_t _inputPos = 0, _inputLen = 0;
+    uint8_t _carry[8];              // Read-ahead from before the last refill (see giveBackReadAhead)
+    uint8_t _carryPos = 0, _carryLen = 0;
+
+    uint32_t _crc = 0;
+    size_t _wireBytes = 0;
+    size_t _payloadBytes = 0;
+
+    bool refillInput();
+    bool inputByte(uint8_t &b);
+    bool skipGzipHeader();
+    void giveBackReadAhead();
+    bool checkGzipTrailer();
+    bool inflateMore();
+};
+
+#endif
@@ -1,23 +1,47 @@
 #include "LedManager.h"
 
-LedManager statusLed(PIN_RGB_LED, 1);
+LedManager statusLed(PIN_RGB_LED, PIN_LED_POWER);
 
-LedManager::LedManager(int pin, int numPixels) 
-    : _pixels(numPixels, pin, NEO_GRB + NEO_KHZ800), _currentState(LED_OFF)
+// (1 - cos) / 2 over one period, 0..255
+static const uint8_t BREATH_CURVE[LED_CURVE_STEPS] = {
+      0,   1,   2,   5,  10,  15,  21,  29,  37,  47,  57,  67,  79,  90, 103, 115,
+    127, 140, 152, 165, 176, 188, 198, 208, 218, 226, 234, 240, 245, 250, 253, 254,
+    255, 254, 253, 250, 245, 240, 234, 226, 218, 208, 198, 188, 176, 165, 152, 140,
+    128, 115, 103,  90,  79,  67,  57,  47,  37,  29,  21,  15,  10,   5,   2,   1,
+};
+
+// Full breathing periods (close to the previous sin(t / 1000) and sin(t / 500))
+const uint32_t UPDATING_PERIOD_MS = 6400;
+const uint32_t CONFIG_PERIOD_MS = 3200;
+
+// Idle blink: LED (and its rail) off almost all of the time
+const uint32_t IDLE_BLINK_ON_MS = 60;
+const uint32_t IDLE_BLINK_PERIOD_MS = 4000;
+
+static inline uint8_t scale(uint8_t value, uint8_t level) {
+    return ((uint16_t)value * level + 127) / 255;
+}
+
+LedManager::LedManager(int pin, int powerPin)
+    : _pin(pin), _powerPin(powerPin), _currentState(LED_OFF), _shownState(LED_OFF),
+      _powered(false), _step(0), _taskHandle(NULL)
 {
 }
 
 void LedManager::begin() {
-    _pixels.begin();
-    _pixels.clear();
-    _pixels.show();
-    _pixels.setBrightness(20); 
+    if (_powerPin >= 0) {
+        pinMode(_powerPin, OUTPUT);
+        digitalWrite(_powerPin, LOW);
+    }
+    setPower(true);
+    write(0, 0, 0);
+    setPower(false);
 
     // Create Task
     xTaskCreatePinnedToCore(
         LedManager::taskFunction,
         "LedTask",
-        4096,
+        2048,
         this,
         1,
         &_taskHandle,
@@ -26,71 +50,83 @@ void LedManager::begin() {
 }
 
 void LedManager::setState(LedState state) {
+    if (state == _currentState) return;
     _currentState = state;
+    if (_taskHandle) xTaskNotifyGive(_taskHandle);
 }
 
 void LedManager::taskFunction(void* parameter) {
     LedManager* lm = (LedManager*)parameter;
-    
+    TickType_t wait = portMAX_DELAY;
+
     while(true) {
-        lm->loop();
-        vTaskDelay(pdMS_TO_TICKS(20)); // Update every 20ms
+        // Static states sleep until the next setState(), animations until their next step
+        ulTaskNotifyTake(pdTRUE, wait);
+        wait = lm->render();
     }
 }
 
-void LedManager::loop() {
-    unsigned long t = millis();
-    
-    switch (_currentState) {
+TickType_t LedManager::render() {
+    LedState state = _currentState;
+    if (state != _shownState) {
+        _shownState = state;
+        _step = 0;
+    }
+
+    switch (state) {
         case LED_OFF:
-             // Only clear if not already cleared? 
-             // Ideally we just keep showing clear. 
-             // To avoid spamming show(), check state change or simple timer? 
-             // NeoPixel.show() disables interrupts briefly. 20ms is 50Hz. acceptable.
-             _pixels.clear();
-             _pixels.show();
-             break;
+            write(0, 0, 0);
+            setPower(false);
+            return portMAX_DELAY;
 
         case LED_RUNNING:
             // Solid Green
-            _pixels.setPixelColor(0, _pixels.Color(0, 255, 0));
-            _pixels.show();
-            break;
+            setPower(true);
+            write(0, 255, 0);
+            return portMAX_DELAY;
 
-        case LED_UPDATING:
-        {
+        case LED_UPDATING: {
             // Alternating Blue/Green (Crossfade)
-            // sin wave -1 to 1
-            float val = sin(t / 1000.0); 
-            // map to 0 to 1
-            float pos = (val + 1.0) / 2.0; 
-
-            // Linear crossfade
-            uint8_t g = (uint8_t)(255 * (1.0 - pos));
-            uint8_t b = (uint8_t)(255 * pos);
-            
-            _pixels.setPixelColor(0, _pixels.Color(0, g, b));
-            _pixels.show();
-            break;
+            setPower(true);
+            uint8_t pos = BREATH_CURVE[_step];
+            write(0, 255 - pos, pos);
+            _step = (_step + 1) % LED_CURVE_STEPS;
+            return pdMS_TO_TICKS(UPDATING_PERIOD_MS / LED_CURVE_STEPS);
         }
 
-        case LED_CONFIG:
-        {
-            // Orange Breathing
-            float b = (sin(t / 500.0) + 1.0) / 2.0; 
-            b = 0.1 + (b * 0.9);
-
-            uint8_t r = (uint8_t)(255 * b);
-            uint8_t g = (uint8_t)(165 * b);
-            
-            _pixels.setPixelColor(0, _pixels.Color(r, g, 0));
-            _pixels.show();
-            break;
+        case LED_CONFIG: {
+            // Orange Breathing, never fully dark (10% .. 100%)
+            setPower(true);
+            uint8_t level = 26 + scale(BREATH_CURVE[_step], 229);
+            write(scale(255, level), scale(165, level), 0);
+            _step = (_step + 1) % LED_CURVE_STEPS;
+            return pdMS_TO_TICKS(CONFIG_PERIOD_MS / LED_CURVE_STEPS);
         }
+
+        case LED_CONFIG_IDLE:
+            _step = !_step;
+            if (_step) {
+                setPower(true);
+                write(255, 165, 0);
+                return pdMS_TO_TICKS(IDLE_BLINK_ON_MS);
+            }
+            write(0, 0, 0);
+            setPower(false);
+            return pdMS_TO_TICKS(IDLE_BLINK_PERIOD_MS - IDLE_BLINK_ON_MS);
     }
+    return portMAX_DELAY;
+}
+
+// neopixelWrite() clocks the WS2812 out through RMT, so interrupts stay enabled
+void LedManager::write(uint8_t r, uint8_t g, uint8_t b) {
+    if (!_powered) return;
+    neopixelWrite(_pin, scale(r, LED_BRIGHTNESS), scale(g, LED_BRIGHTNESS), scale(b, LED_BRIGHTNESS));
 }
 
-void LedManager::setBrightnessColor(uint8_t r, uint8_t g, uint8_t b, float brightness) {
-    _pixels.setPixelColor(0, _pixels.Color((uint8_t)(r*brightness), (uint8_t)(g*brightness), (uint8_t)(b*brightness)));
-    _pixels.show();
+void LedManager::setPower(bool on) {
+    if (on == _powered) return;
+    _powered = on;
+    if (_powerPin < 0) return;
+    digitalWrite(_powerPin, on ? HIGH : LOW);
+    if (on) delayMicroseconds(100); // Let the WS2812 come out of reset
 }
@@ -2,33 +2,41 @@
 #define LED_MANAGER_H
 
 #include <Arduino.h>
-#include <Adafruit_NeoPixel.h>
 #include "Settings.h"
 
 enum LedState {
     LED_OFF,
     LED_RUNNING,    // Green Solid
     LED_UPDATING,   // Blue/Green (Cyan) Breathing
-    LED_CONFIG      // Orange Breathing
+    LED_CONFIG,     // Orange Breathing
+    LED_CONFIG_IDLE // Short orange blink, config mode waiting with slow advertising
 };
 
+// Global brightness (0-255) applied to every colour
+const uint8_t LED_BRIGHTNESS = 20;
+
+// Breathing curves are sampled from a 64 step table, one step per wake
+const int LED_CURVE_STEPS = 64;
+
 class LedManager {
 public:
-    LedManager(int pin, int numPixels = 1);
+    LedManager(int pin, int powerPin = -1);
     void begin();
-    void loop();
     void setState(LedState state);
 
 private:
-    Adafruit_NeoPixel _pixels;
-    LedState _currentState;
-    
-    // Animation helpers
-    uint32_t _targetColor;
+    int _pin;
+    int _powerPin;        // Optional high-side switch for the LED rail, -1 = none
+    volatile LedState _currentState;
+    LedState _shownState;
+    bool _powered;
+    uint8_t _step;
     TaskHandle_t _taskHandle;
-    
+
     static void taskFunction(void* parameter);
-    void setBrightnessColor(uint8_t r, uint8_t g, uint8_t b, float brightness);
+    TickType_t render();  // Draw the current frame, returns ticks until the next one
+    void write(uint8_t r, uint8_t g, uint8_t b);
+    void setPower(bool on);
 };
 
 extern LedManager statusLed;
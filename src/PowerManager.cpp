@@ -0,0 +1,85 @@
+#include "PowerManager.h"
+#include "Telemetry.h"
+
+PowerManager power;
+
+// Typical current per wake phase (mA) at 80 MHz, panel included. Indexed by TelemetryPhase.
+static const float PHASE_CURRENT_MA[] = {
+    95.0f,  // PHASE_WIFI
+    110.0f, // PHASE_FETCH
+    35.0f,  // PHASE_RENDER
+    40.0f,  // PHASE_REFRESH
+    100.0f  // PHASE_DNS
+};
+static_assert(sizeof(PHASE_CURRENT_MA) / sizeof(PHASE_CURRENT_MA[0]) == PHASE_COUNT,
+              "One current per TelemetryPhase");
+
+// Li-ion open-circuit curve (mV -> %), light load
+static const uint16_t DISCHARGE_MV[] = {4200, 4100, 4000, 3900, 3800, 3700, 3600, 3500, 3400, 3300};
+static const uint8_t DISCHARGE_PCT[] = {100, 90, 79, 66, 52, 37, 22, 11, 4, 0};
+const int DISCHARGE_POINTS = sizeof(DISCHARGE_MV) / sizeof(DISCHARGE_MV[0]);
+
+void PowerManager::begin() {
+    _batteryMv = sampleMv();
+    if (_batteryMv < BATTERY_ABSENT_MV) {
+        _tier = POWER_EXTERNAL;
+        _percent = 0;
+        return;
+    }
+
+    _percent = percentFromMv(_batteryMv);
+    if (_percent >= 50) _tier = POWER_NORMAL;
+    else if (_percent >= 20) _tier = POWER_SAVER;
+    else if (_percent >= 10) _tier = POWER_LOW;
+    else _tier = POWER_CRITICAL;
+
+    telemetry.setBatteryMv(_batteryMv);
+}
+
+// analogReadMilliVolts() applies the eFuse ADC calibration; average to flatten noise
+uint16_t PowerManager::sampleMv() {
+    pinMode(PIN_BATTERY_ADC, INPUT);
+    analogSetPinAttenuation(PIN_BATTERY_ADC, ADC_11db);
+    uint32_t sum = 0;
+    for (int i = 0; i < 8; i++) sum += analogReadMilliVolts(PIN_BATTERY_ADC);
+    return (uint16_t)(sum / 8 * BATTERY_DIVIDER);
+}
+
+uint8_t PowerManager::percentFromMv(uint16_t mv) {
+    if (mv >= DISCHARGE_MV[0]) return 100;
+    for (int i = 1; i < DISCHARGE_POINTS; i++) {
+        if (mv >= DISCHARGE_MV[i]) {
+            // Linear between the two points
+            uint16_t span = DISCHARGE_MV[i - 1] - DISCHARGE_MV[i];
+            return DISCHARGE_PCT[i] + (DISCHARGE_PCT[i - 1] - DISCHARGE_PCT[i]) * (mv - DISCHARGE_MV[i]) / span;
+        }
+    }
+    return 0;
+}
+
+unsigned long PowerManager::refreshMs(unsigned long configuredMs) const {
+    switch (_tier) {
+        case POWER_SAVER:    return configuredMs * 2;
+        case POWER_LOW:      return configuredMs * 4;
+        case POWER_CRITICAL: return configuredMs * 8;
+        default:             return configuredMs;
+    }
+}
+
+float PowerManager::estimateDays(unsigned long refreshMs) const {
+    WakeRecord avg;
+    if (!hasBattery() || refreshMs == 0 || !telemetry.averageCycle(avg)) return -1;
+
+    // Charge per wake: each phase at its own current, the rest of the awake time at idle
+    float mAs = 0;
+    uint32_t phaseTotal = 0;
+    for (int ph = 0; ph < PHASE_COUNT; ph++) {
+        mAs += avg.phaseMs[ph] * PHASE_CURRENT_MA[ph] / 1000.0f;
+        phaseTotal += avg.phaseMs[ph];
+    }
+    if (avg.totalMs > phaseTotal) mAs += (avg.totalMs - phaseTotal) * AWAKE_IDLE_MA / 1000.0f;
+
+    float wakesPerDay = 86400000.0f / refreshMs;
+    float mAhPerDay = wakesPerDay * mAs / 3600.0f + DEEP_SLEEP_MA * 24.0f;
+    return BATTERY_CAPACITY_MAH * _percent / 100.0f / mAhPerDay;
+}
@@ -0,0 +1,51 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include "Settings.h"
+
+// Energy tiers, picked from the state of charge
+enum PowerTier : uint8_t {
+    POWER_NORMAL,    // >= 50 %: configured behaviour
+    POWER_SAVER,     // >= 20 %: refresh interval x2
+    POWER_LOW,       // >= 10 %: x4, no weather, partial refresh preferred
+    POWER_CRITICAL,  //  < 10 %: x8, no weather, partial refresh preferred
+    POWER_EXTERNAL   // No battery detected (USB powered)
+};
+
+// Energy model, see PHASE_CURRENT_MA in PowerManager.cpp for the per-phase currents
+const float AWAKE_IDLE_MA = 30.0f;   // Awake time outside the timed phases
+const float DEEP_SLEEP_MA = 0.15f;   // SoC + panel + divider in deep sleep
+
+const uint16_t BATTERY_ABSENT_MV = 2500; // Below this the ADC sees no cell
+
+class PowerManager {
+public:
+    // Sample the battery and pick the tier for this wake cycle
+    void begin();
+
+    uint16_t batteryMv() const { return _batteryMv; }
+    bool hasBattery() const { return _tier != POWER_EXTERNAL; }
+    uint8_t percent() const { return _percent; }
+    PowerTier tier() const { return _tier; }
+
+    // --- Policy ---
+    unsigned long refreshMs(unsigned long configuredMs) const;
+    bool allowWeather() const { return _tier < POWER_LOW || _tier == POWER_EXTERNAL; }
+    bool preferPartial() const { return _tier == POWER_LOW || _tier == POWER_CRITICAL; }
+
+    // Remaining runtime from the energy model and the recorded wake cycles, -1 = unknown
+    float estimateDays(unsigned long refreshMs) const;
+
+private:
+    uint16_t _batteryMv = 0;
+    uint8_t _percent = 0;
+    PowerTier _tier = POWER_EXTERNAL;
+
+    static uint16_t sampleMv();
+    static uint8_t percentFromMv(uint16_t mv);
+};
+
+extern PowerManager power;
+
+#endif
@@ -0,0 +1,328 @@
+#include "QrEncoder.h"
+
+// Index [ecc][version], version 0 unused
+static const int8_t ECC_PER_BLOCK[2][QR_MAX_VERSION + 1] = {
+    {-1, 7, 10, 15, 20, 26, 18, 20, 24, 30, 18},  // L
+    {-1, 10, 16, 26, 18, 24, 16, 18, 22, 22, 26}, // M
+};
+static const int8_t NUM_BLOCKS[2][QR_MAX_VERSION + 1] = {
+    {-1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 4}, // L
+    {-1, 1, 1, 1, 2, 2, 4, 4, 4, 5, 5}, // M
+};
+// Format information encoding of the ECC level
+static const uint8_t ECC_FORMAT_BITS[2] = {1, 0};
+
+int QrEncoder::rawCodewords(int version) {
+    int bits = (16 * version + 128) * version + 64;
+    if (version >= 2) {
+        int numAlign = version / 7 + 2;
+        bits -= (25 * numAlign - 10) * numAlign - 55;
+        if (version >= 7) bits -= 36;
+    }
+    return bits / 8;
+}
+
+int QrEncoder::dataCodewords(int version, Ecc ecc) {
+    return rawCodewords(version) - ECC_PER_BLOCK[ecc][version] * NUM_BLOCKS[ecc][version];
+}
+
+int QrEncoder::alignmentPositions(int version, uint8_t *out) {
+    if (version == 1) return 0;
+    int numAlign = version / 7 + 2;
+    int step = (version * 4 + numAlign * 2 + 1) / (numAlign * 2 - 2) * 2;
+    out[0] = 6;
+    for (int i = numAlign - 1, pos = version * 4 + 10; i >= 1; i--, pos -= step)
+        out[i] = pos;
+    return numAlign;
+}
+
+// --- Reed-Solomon over GF(2^8), polynomial 0x11D ---
+static uint8_t gfMultiply(uint8_t x, uint8_t y) {
+    int z = 0;
+    for (int i = 7; i >= 0; i--) {
+        z = (z << 1) ^ ((z >> 7) * 0x11D);
+        z ^= ((y >> i) & 1) * x;
+    }
+    return z;
+}
+
+void QrEncoder::reedSolomon(const uint8_t *data, int len, int degree, uint8_t *ecc) {
+    // Generator polynomial, highest coefficient (always 1) dropped
+    uint8_t divisor[30];
+    memset(divisor, 0, degree);
+    divisor[degree - 1] = 1;
+    uint8_t root = 1;
+    for (int i = 0; i < degree; i++) {
+        for (int j = 0; j < degree; j++) {
+            divisor[j] = gfMultiply(divisor[j], root);
+            if (j + 1 < degree) divisor[j] ^= divisor[j + 1];
+        }
+        root = gfMultiply(root, 0x02);
+    }
+
+    memset(ecc, 0, degree);
+    for (int i = 0; i < len; i++) {
+        uint8_t factor = data[i] ^ ecc[0];
+        memmove(ecc, ecc + 1, degree - 1);
+        ecc[degree - 1] = 0;
+        for (int j = 0; j < degree; j++)
+            ecc[j] ^= gfMultiply(divisor[j], factor);
+    }
+}
+
+// --- Matrix helpers ---
+void QrEncoder::setModule(int x, int y, bool dark) {
+    uint8_t mask = 0x80 >> (x & 7);
+    if (dark) _modules[y][x >> 3] |= mask;
+    else _modules[y][x >> 3] &= ~mask;
+}
+
+void QrEncoder::setFunction(int x, int y, bool dark) {
+    setModule(x, y, dark);
+    _isFunction[y][x >> 3] |= 0x80 >> (x & 7);
+}
+
+void QrEncoder::drawFinder(int cx, int cy) {
+    for (int dy = -4; dy <= 4; dy++) {
+        for (int dx = -4; dx <= 4; dx++) {
+            int dist = max(abs(dx), abs(dy));
+            int x = cx + dx, y = cy + dy;
+            if (x >= 0 && x < _size && y >= 0 && y < _size)
+                setFunction(x, y, dist != 2 && dist != 4);
+        }
+    }
+}
+
+void QrEncoder::drawAlignment(int cx, int cy) {
+    for (int dy = -2; dy <= 2; dy++)
+        for (int dx = -2; dx <= 2; dx++)
+            setFunction(cx + dx, cy + dy, max(abs(dx), abs(dy)) != 1);
+}
+
+void QrEncoder::drawFormatBits(int mask) {
+    int data = ECC_FORMAT_BITS[_ecc] << 3 | mask;
+    int rem = data;
+    for (int i = 0; i < 10; i++)
+        rem = (rem << 1) ^ ((rem >> 9) * 0x537);
+    int bits = (data << 10 | rem) ^ 0x5412;
+
+    // Around the top-left finder
+    for (int i = 0; i <= 5; i++) setFunction(8, i, (bits >> i) & 1);
+    setFunction(8, 7, (bits >> 6) & 1);
+    setFunction(8, 8, (bits >> 7) & 1);
+    setFunction(7, 8, (bits >> 8) & 1);
+    for (int i = 9; i < 15; i++) setFunction(14 - i, 8, (bits >> i) & 1);
+
+    // Split between the other two finders
+    for (int i = 0; i < 8; i++) setFunction(_size - 1 - i, 8, (bits >> i) & 1);
+    for (int i = 8; i < 15; i++) setFunction(8, _size - 15 + i, (bits >> i) & 1);
+    setFunction(8, _size - 8, true); // Dark module
+}
+
+void QrEncoder::drawVersion() {
+    if (_version < 7) return;
+    int rem = _version;
+    for (int i = 0; i < 12; i++)
+        rem = (rem << 1) ^ ((rem >> 11) * 0x1F25);
+    long bits = (long)_version << 12 | rem;
+    for (int i = 0; i < 18; i++) {
+        bool bit = (bits >> i) & 1;
+        int a = _size - 11 + i % 3;
+        int b = i / 3;
+        setFunction(a, b, bit);
+        setFunction(b, a, bit);
+    }
+}
+
+void QrEncoder::drawFunctionPatterns() {
+    for (int i = 0; i < _size; i++) {
+        setFunction(6, i, i % 2 == 0);
+        setFunction(i, 6, i % 2 == 0);
+    }
+
+    drawFinder(3, 3);
+    drawFinder(_size - 4, 3);
+    drawFinder(3, _size - 4);
+
+    uint8_t pos[7];
+    int numAlign = alignmentPositions(_version, pos);
+    for (int i = 0; i < numAlign; i++) {
+        for (int j = 0; j < numAlign; j++) {
+            // Skip the three finder corners
+            if ((i == 0 && j == 0) || (i == 0 && j == numAlign - 1) || (i == numAlign - 1 && j == 0))
+                continue;
+            drawAlignment(pos[i], pos[j]);
+        }
+    }
+
+    drawFormatBits(0); // Placeholder, reserves the area
+    drawVersion();
+}
+
+// Zig-zag placement, two columns at a time from the bottom right
+void QrEncoder::drawCodewords(const uint8_t *data, int len) {
+    int i = 0;
+    for (int right = _size - 1; right >= 1; right -= 2) {
+        if (right == 6) right = 5;
+        for (int vert = 0; vert < _size; vert++) {
+            for (int j = 0; j < 2; j++) {
+                int x = right - j;
+                bool upward = ((right + 1) & 2) == 0;
+                int y = upward ? _size - 1 - vert : vert;
+                if (!isFunction(x, y) && i < len * 8) {
+                    setModule(x, y, (data[i >> 3] >> (7 - (i & 7))) & 1);
+                    i++;
+                }
+            }
+        }
+    }
+}
+
+void QrEncoder::applyMask(int mask) {
+    for (int y = 0; y < _size; y++) {
+        for (int x = 0; x < _size; x++) {
+            bool invert;
+            switch (mask) {
+                case 0: invert = (x + y) % 2 == 0; break;
+                case 1: invert = y % 2 == 0; break;
+                case 2: invert = x % 3 == 0; break;
+                case 3: invert = (x + y) % 3 == 0; break;
+                case 4: invert = (x / 3 + y / 2) % 2 == 0; break;
+                case 5: invert = x * y % 2 + x * y % 3 == 0; break;
+                case 6: invert = (x * y % 2 + x * y % 3) % 2 == 0; break;
+                default: invert = ((x + y) % 2 + x * y % 3) % 2 == 0; break;
+            }
+            if (invert && !isFunction(x, y))
+                _modules[y][x >> 3] ^= 0x80 >> (x & 7);
+        }
+    }
+}
+
+// Standard penalty rules N1-N4
+long QrEncoder::penalty() const {
+    long result = 0;
+    int dark = 0;
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int a = 0; a < _size; a++) {
+            int run = 0;
+            bool runColor = false;
+            uint16_t window = 0; // Last 11 modules, for the finder-like rule
+            for (int b = 0; b < _size; b++) {
+                bool m = pass == 0 ? module(b, a) : module(a, b);
+                if (pass == 0 && m) dark++;
+
+                if (b > 0 && m == runColor) {
+                    run++;
+                    if (run == 5) result += 3;
+                    else if (run > 5) result++;
+                } else {
+                    runColor = m;
+                    run = 1;
+                }
+
+                window = ((window << 1) | m) & 0x7FF;
+                if (b >= 10 && (window == 0x5D0 || window == 0x05D)) // 1011101 + 4 light
+                    result += 40;
+            }
+        }
+    }
+
+    for (int y = 0; y < _size - 1; y++) {
+        for (int x = 0; x < _size - 1; x++) {
+            bool c = module(x, y);
+            if (c == module(x + 1, y) && c == module(x, y + 1) && c == module(x + 1, y + 1))
+                result += 3;
+        }
+    }
+
+    int total = _size * _size;
+    int k = (abs(dark * 20 - total * 10) + total - 1) / total - 1;
+    result += k * 10;
+    return result;
+}
+
+bool QrEncoder::encode(const uint8_t *data, size_t len) {
+    // Smallest version at ECC L, then boost to M if it still fits
+    _version = 0;
+    for (int v = 1; v <= QR_MAX_VERSION; v++) {
+        int headerBits = 4 + (v < 10 ? 8 : 16);
+        if ((int)(headerBits + len * 8 + 7) / 8 <= dataCodewords(v, ECC_L)) {
+            _version = v;
+            break;
+        }
+    }
+    if (_version == 0) return false;
+
+    int headerBits = 4 + (_version < 10 ? 8 : 16);
+    _ecc = ((int)(headerBits + len * 8 + 7) / 8 <= dataCodewords(_version, ECC_M)) ? ECC_M : ECC_L;
+    _size = _version * 4 + 17;
+
+    // --- Data codewords: mode, length, payload, terminator, padding ---
+    uint8_t codewords[QR_MAX_CODEWORDS];
+    int capacity = dataCodewords(_version, _ecc);
+    memset(codewords, 0, sizeof(codewords));
+    int bitLen = 0;
+    auto appendBits = [&](uint32_t val, int n) {
+        for (int i = n - 1; i >= 0; i--, bitLen++)
+            codewords[bitLen >> 3] |= ((val >> i) & 1) << (7 - (bitLen & 7));
+    };
+    appendBits(0x4, 4); // Byte mode
+    appendBits(len, headerBits - 4);
+    for (size_t i = 0; i < len; i++) appendBits(data[i], 8);
+    appendBits(0, min(4, capacity * 8 - bitLen));
+    bitLen = (bitLen + 7) & ~7;
+    for (uint8_t pad = 0xEC; bitLen < capacity * 8; pad ^= 0xEC ^ 0x11)
+        appendBits(pad, 8);
+
+    // --- Split into blocks, add ECC and interleave ---
+    int numBlocks = NUM_BLOCKS[_ecc][_version];
+    int eccLen = ECC_PER_BLOCK[_ecc][_version];
+    int raw = rawCodewords(_version);
+    int numShort = numBlocks - raw % numBlocks;
+    int shortLen = raw / numBlocks; // Data + ECC of a short block
+
+    uint8_t blockEcc[5][30];
+    int blockStart[5];
+    for (int b = 0, k = 0; b < numBlocks; b++) {
+        int dataLen = shortLen - eccLen + (b < numShort ? 0 : 1);
+        blockStart[b] = k;
+        reedSolomon(codewords + k, dataLen, eccLen, blockEcc[b]);
+        k += dataLen;
+    }
+
+    uint8_t interleaved[QR_MAX_CODEWORDS];
+    int n = 0;
+    for (int i = 0; i <= shortLen - eccLen; i++) {
+        for (int b = 0; b < numBlocks; b++) {
+            // Short blocks have one data codeword less
+            if (i == shortLen - eccLen && b < numShort) continue;
+            interleaved[n++] = codewords[blockStart[b] + i];
+        }
+    }
+    for (int i = 0; i < eccLen; i++)
+        for (int b = 0; b < numBlocks; b++)
+            interleaved[n++] = blockEcc[b][i];
+
+    // --- Matrix ---
+    memset(_modules, 0, sizeof(_modules));
+    memset(_isFunction, 0, sizeof(_isFunction));
+    drawFunctionPatterns();
+    drawCodewords(interleaved, n);
+
+    int bestMask = 0;
+    long bestPenalty = LONG_MAX;
+    for (int mask = 0; mask < 8; mask++) {
+        applyMask(mask);
+        drawFormatBits(mask);
+        long p = penalty();
+        if (p < bestPenalty) {
+            bestPenalty = p;
+            bestMask = mask;
+        }
+        applyMask(mask); // XOR again to undo
+    }
+    applyMask(bestMask);
+    drawFormatBits(bestMask);
+    return true;
+}
@@ -0,0 +1,52 @@
+#ifndef QR_ENCODER_H
+#define QR_ENCODER_H
+
+#include <Arduino.h>
+
+// Byte-mode QR encoder (versions 1-10, ECC L/M) into a bit-packed matrix.
+// Version 10-L holds 271 bytes, enough for any escaped WIFI: payload
+// with a 32 byte SSID and a 64 byte passphrase.
+const int QR_MAX_VERSION = 10;
+const int QR_MAX_SIZE = QR_MAX_VERSION * 4 + 17;   // 57 modules
+const int QR_ROW_BYTES = (QR_MAX_SIZE + 7) / 8;
+const int QR_MAX_CODEWORDS = 346;                   // Raw codewords of version 10
+
+class QrEncoder {
+public:
+    // Returns false if the data does not fit into QR_MAX_VERSION
+    bool encode(const uint8_t *data, size_t len);
+
+    int size() const { return _size; }
+    bool module(int x, int y) const { return _modules[y][x >> 3] & (0x80 >> (x & 7)); }
+    // Row y, MSB first, one bit per module
+    const uint8_t *row(int y) const { return _modules[y]; }
+
+private:
+    enum Ecc { ECC_L, ECC_M };
+
+    int _size = 0;
+    int _version = 0;
+    Ecc _ecc = ECC_L;
+    uint8_t _modules[QR_MAX_SIZE][QR_ROW_BYTES];
+    uint8_t _isFunction[QR_MAX_SIZE][QR_ROW_BYTES];
+
+    void setModule(int x, int y, bool dark);
+    void setFunction(int x, int y, bool dark);
+    bool isFunction(int x, int y) const { return _isFunction[y][x >> 3] & (0x80 >> (x & 7)); }
+
+    void drawFunctionPatterns();
+    void drawFinder(int cx, int cy);
+    void drawAlignment(int cx, int cy);
+    void drawFormatBits(int mask);
+    void drawVersion();
+    void drawCodewords(const uint8_t *data, int len);
+    void applyMask(int mask);
+    long penalty() const;
+
+    static int rawCodewords(int version);
+    static int dataCodewords(int version, Ecc ecc);
+    static int alignmentPositions(int version, uint8_t *out);
+    static void reedSolomon(const uint8_t *data, int len, int degree, uint8_t *ecc);
+};
+
+#endif
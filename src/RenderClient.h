@@ -0,0 +1,138 @@
+#ifndef RENDER_CLIENT_H
+#define RENDER_CLIENT_H
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <WiFiClientSecure.h>
+#include <esp_rom_crc.h>
+#include "Settings.h"
+#include "WeAct_EInk.h"
+#include "FrameCodec.h"
+#include "LedManager.h"
+#include "Telemetry.h"
+
+// Reference the global display object defined in main.cpp
+extern DisplayDriver display;
+extern bool panelRefreshPending; // SBB_Logic.h
+void finishPanelRefresh();       // SBB_Logic.h
+
+// --- Thin client frame response ---
+// FrameHeader (FrameCodec.h) followed by the encoded black plane, then the red plane.
+// The hash doubles as ETag: the device sends it as If-None-Match and an
+// unchanged frame comes back as 304.
+
+// Hash of the frame that is on the panel, 0 = something else is. Survives deep sleep
+// and ESP.restart(), so every other draw has to clear it (a 304 would keep the wrong screen).
+RTC_DATA_ATTR uint32_t frameOnPanel = 0;
+uint32_t frameLoaded = 0; // In the framebuffers, waiting for pushFrame()
+
+enum FrameResult
+{
+    FRAME_FAILED,    // Fall back to local rendering
+    FRAME_UNCHANGED, // 304, the panel already shows it
+    FRAME_LOADED     // Decoded into the framebuffers
+};
+
+bool readFramePlane(Stream &in, uint8_t encoding, size_t len, uint8_t *out, size_t outLen)
+{
+    if (encoding == FRAME_RAW)
+        return len == outLen && in.readBytes(out, outLen) == outLen;
+    if (encoding == FRAME_PACKBITS)
+        return unpackBits(in, len, out, outLen);
+    return false;
+}
+
+// Fetch a pre-rendered frame from RENDER_URL into the framebuffers, network only.
+// `force` skips the If-None-Match check.
+FrameResult fetchFrame(bool force)
+{
+    if (WiFi.status() != WL_CONNECTED || RENDER_URL.length() == 0)
+        return FRAME_FAILED;
+
+    String q = STATION_NAME;
+    q.replace(" ", "%20");
+    String url = RENDER_URL + (RENDER_URL.indexOf('?') < 0 ? "?" : "&") + "station=" + q + "&limit=" + String(FETCH_LIMIT);
+    Serial.println("Fetching frame: " + url);
+
+    WiFiClient plainClient;
+    WiFiClientSecure secureClient;
+    secureClient.setInsecure();
+    WiFiClient &client = RENDER_URL.startsWith("https") ? secureClient : plainClient;
+
+    HTTPClient http;
+    if (!http.begin(client, url))
+        return FRAME_FAILED;
+    if (!force && frameOnPanel != 0)
+    {
+        char etag[12];
+        snprintf(etag, sizeof(etag), "\"%08x\"", (unsigned)frameOnPanel);
+        http.addHeader("If-None-Match", etag);
+    }
+
+    statusLed.setState(LED_UPDATING);
+    telemetry.phaseStart(PHASE_FETCH);
+    int httpCode = http.GET();
+    FrameResult result = FRAME_FAILED;
+
+    if (httpCode == HTTP_CODE_NOT_MODIFIED)
+    {
+        telemetry.phaseEnd(PHASE_FETCH);
+        Serial.println("Frame unchanged -> No refresh");
+        result = FRAME_UNCHANGED;
+    }
+    else if (httpCode == HTTP_CODE_OK)
+    {
+        const size_t planeLen = PanelGeometry::planeBytes;
+        finishPanelRefresh(); // The planes are about to be overwritten
+        Stream &in = *http.getStreamPtr();
+        FrameHeader header;
+        bool valid = in.readBytes((uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+                     memcmp(header.magic, "EFRM", 4) == 0 && header.version == FRAME_VERSION &&
+                     header.width == EINK_WIDTH && header.height == EINK_HEIGHT;
+        valid = valid && readFramePlane(in, header.encoding, header.blackLen, display.blackBuffer, planeLen) &&
+                readFramePlane(in, header.encoding, header.redLen, display.redBuffer, planeLen);
+        if (valid)
+        {
+            uint32_t crc = esp_rom_crc32_le(0, display.blackBuffer, planeLen);
+            valid = esp_rom_crc32_le(crc, display.redBuffer, planeLen) == header.hash;
+        }
+        telemetry.phaseEnd(PHASE_FETCH);
+
+        if (valid)
+        {
+            Serial.printf("Frame %08x: %u bytes for %u\n", (unsigned)header.hash,
+                          (unsigned)(sizeof(header) + header.blackLen + header.redLen), (unsigned)(2 * planeLen));
+            frameLoaded = header.hash;
+            display.scanRedPlane();
+            result = FRAME_LOADED;
+        }
+        else
+        {
+            telemetry.setError(ERR_FRAME);
+            Serial.println("Frame invalid");
+        }
+    }
+    else
+    {
+        telemetry.phaseEnd(PHASE_FETCH);
+        telemetry.setError(ERR_HTTP);
+        Serial.print("Render HTTP Error: ");
+        Serial.println(httpCode);
+    }
+
+    http.end();
+    statusLed.setState(LED_OFF);
+    return result;
+}
+
+// Push the frame left by fetchFrame(), runs with the radio already off.
+// Returns while the panel refreshes, finishPanelRefresh() collects it.
+void pushFrame()
+{
+    telemetry.phaseStart(PHASE_REFRESH);
+    display.displayAsync();
+    panelRefreshPending = true;
+    frameOnPanel = frameLoaded;
+}
+
+#endif
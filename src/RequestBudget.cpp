@@ -0,0 +1,98 @@
+#include "RequestBudget.h"
+#include <time.h>
+#include "WallClock.h"
+
+RequestBudget budget;
+
+// Ledger survives deep sleep (a power cycle starts a fresh day)
+RTC_DATA_ATTR uint32_t rtcBudgetDay = 0;                 // Local year / day of year, 0 = clock never set
+RTC_DATA_ATTR uint16_t rtcApiCalls[API_COUNT] = {0};
+RTC_DATA_ATTR time_t rtcBlockedUntil[API_COUNT] = {0};   // Server asked us to back off (429)
+RTC_DATA_ATTR uint8_t rtcManualTokens = MANUAL_TOKENS;
+RTC_DATA_ATTR time_t rtcTokenTime = 0;                   // Last refill
+
+// Quotas reset at local midnight (TZ is set in setup())
+void RequestBudget::rollDay() {
+    time_t now = time(nullptr);
+    if (!wallClock.valid()) return; // Keep counting into the current day
+    struct tm t;
+    localtime_r(&now, &t);
+    uint32_t day = (uint32_t)(t.tm_year + 1900) * 1000 + t.tm_yday + 1;
+    if (day == rtcBudgetDay) return;
+    if (rtcBudgetDay != 0) Serial.printf("Request budget: new day, SBB %u / weather %u calls yesterday\n", rtcApiCalls[API_SBB], rtcApiCalls[API_WEATHER]);
+    rtcBudgetDay = day;
+    memset(rtcApiCalls, 0, sizeof(rtcApiCalls));
+}
+
+uint16_t RequestBudget::used(ApiId api) const {
+    rollDay();
+    return rtcApiCalls[api];
+}
+
+bool RequestBudget::allow(ApiId api) const {
+    time_t now = time(nullptr);
+    if (now < rtcBlockedUntil[api]) {
+        Serial.printf("API %u rate limited for another %lds\n", api, (long)(rtcBlockedUntil[api] - now));
+        return false;
+    }
+    if (used(api) >= API_DAILY_BUDGET[api]) {
+        Serial.printf("API %u daily budget of %u calls used up\n", api, API_DAILY_BUDGET[api]);
+        return false;
+    }
+    return true;
+}
+
+void RequestBudget::record(ApiId api, int httpCode, const String &retryAfter) {
+    rollDay();
+    if (rtcApiCalls[api] < 0xFFFF) rtcApiCalls[api]++;
+    if (httpCode != 429) return;
+
+    // Retry-After in seconds; the HTTP-date form (or none) gets the default
+    long seconds = retryAfter.toInt();
+    if (seconds <= 0) seconds = RATE_LIMIT_DEFAULT_S;
+    if (seconds > (long)RATE_LIMIT_MAX_S) seconds = RATE_LIMIT_MAX_S;
+    rtcBlockedUntil[api] = time(nullptr) + seconds;
+    Serial.printf("API %u: 429 Too Many Requests, backing off %lds\n", api, seconds);
+}
+
+bool RequestBudget::takeManual() {
+    time_t now = time(nullptr);
+    if (now < rtcTokenTime) rtcTokenTime = now; // Clock was set backwards
+    uint32_t refills = (now - rtcTokenTime) / MANUAL_TOKEN_REFILL_S;
+    if (rtcManualTokens + refills >= MANUAL_TOKENS) {
+        rtcManualTokens = MANUAL_TOKENS;
+        rtcTokenTime = now;
+    } else {
+        rtcManualTokens += refills;
+        rtcTokenTime += refills * MANUAL_TOKEN_REFILL_S;
+    }
+
+    if (rtcManualTokens == 0) return false;
+    rtcManualTokens--;
+    return true;
+}
+
+unsigned long RequestBudget::sleepMs(unsigned long normalMs) const {
+    time_t now = time(nullptr);
+    unsigned long ms = normalMs;
+
+    // Wait out the server's backoff instead of waking into another 429
+    if (now < rtcBlockedUntil[API_SBB]) {
+        unsigned long blockedMs = (unsigned long)(rtcBlockedUntil[API_SBB] - now) * 1000;
+        if (blockedMs > ms) ms = blockedMs;
+    }
+    if (!wallClock.valid()) return ms;
+
+    // Spread what is left of today's quota evenly until midnight, so the
+    // evening still gets its updates after a day of frequent presses
+    struct tm t;
+    localtime_r(&now, &t);
+    unsigned long untilMidnightMs = (unsigned long)(86400 - (t.tm_hour * 3600 + t.tm_min * 60 + t.tm_sec)) * 1000;
+    int left = (int)API_DAILY_BUDGET[API_SBB] - MANUAL_RESERVE - used(API_SBB);
+    unsigned long pacedMs = left > 0 ? untilMidnightMs / left : untilMidnightMs + 60000;
+    if (pacedMs > ms) {
+        Serial.printf("Request budget: %d SBB calls left today, next fetch in %lus\n", left, pacedMs / 1000);
+        ms = pacedMs;
+    }
+    return ms;
+}
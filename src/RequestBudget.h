@@ -0,0 +1,45 @@
+#ifndef REQUEST_BUDGET_H
+#define REQUEST_BUDGET_H
+
+#include <Arduino.h>
+
+// Public APIs with a per-client rate limit (the LAN services are not counted)
+enum ApiId : uint8_t {
+    API_SBB,        // transport.opendata.ch stationboard
+    API_WEATHER,    // api.open-meteo.com
+    API_COUNT
+};
+
+// Daily quotas, kept below the public per-client limits
+const uint16_t API_DAILY_BUDGET[API_COUNT] = {1000, 5000};
+const uint16_t MANUAL_RESERVE = 30;                // SBB calls per day held back for button presses
+const uint8_t MANUAL_TOKENS = 3;                   // Button refreshes in a burst
+const uint32_t MANUAL_TOKEN_REFILL_S = 5 * 60;     // One more every 5 minutes
+const uint32_t RATE_LIMIT_DEFAULT_S = 10 * 60;     // 429 without a usable Retry-After
+const uint32_t RATE_LIMIT_MAX_S = 6 * 60 * 60;     // Cap for the server's Retry-After
+
+// Per-day request ledger across deep sleep, with a token bucket for manual refreshes
+class RequestBudget {
+public:
+    // Within today's quota and not backing off after a 429
+    bool allow(ApiId api) const;
+
+    // After every request to a public API, `retryAfter` is the header of a 429
+    void record(ApiId api, int httpCode, const String &retryAfter);
+
+    // Token for a button refresh, false = throttled
+    bool takeManual();
+
+    // Sleep until the next scheduled fetch: at least `normalMs`, longer while
+    // rate limited or when today's remaining quota would not last until midnight
+    unsigned long sleepMs(unsigned long normalMs) const;
+
+    uint16_t used(ApiId api) const;
+
+private:
+    static void rollDay();
+};
+
+extern RequestBudget budget;
+
+#endif
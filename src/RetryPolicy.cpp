@@ -0,0 +1,69 @@
+#include "RetryPolicy.h"
+#include <time.h>
+
+RetryPolicy retry;
+volatile bool RetryPolicy::_authRejected = false;
+
+RTC_DATA_ATTR uint8_t rtcFailures = 0;
+RTC_DATA_ATTR uint8_t rtcAuthFailures = 0;
+RTC_DATA_ATTR time_t rtcRetryAt = 0; // RTC time of the next attempt
+
+void RetryPolicy::begin() {
+    _authRejected = false;
+    WiFi.onEvent(onWiFiEvent, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+}
+
+// Runs in the WiFi event task
+void RetryPolicy::onWiFiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    switch (info.wifi_sta_disconnected.reason) {
+    case WIFI_REASON_AUTH_FAIL:
+    case WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT:
+    case WIFI_REASON_HANDSHAKE_TIMEOUT:
+    case WIFI_REASON_MIC_FAILURE:
+        _authRejected = true;
+        break;
+    default:
+        break;
+    }
+}
+
+void RetryPolicy::success() {
+    if (rtcFailures > 0) Serial.printf("Online again after %u failed attempts\n", rtcFailures);
+    rtcFailures = 0;
+    rtcAuthFailures = 0;
+    rtcRetryAt = 0;
+}
+
+void RetryPolicy::failure(FailureKind kind) {
+    if (rtcFailures < 255) rtcFailures++;
+    if (kind == FAIL_AUTH) {
+        if (rtcAuthFailures < 255) rtcAuthFailures++;
+    } else if (kind == FAIL_NETWORK) {
+        rtcAuthFailures = 0; // Only consecutive rejections count
+    }
+    rtcRetryAt = time(nullptr) + backoffMs(rtcFailures) / 1000;
+    Serial.printf("Failure %u (kind %u), next attempt in %lus\n", rtcFailures, kind, backoffMs(rtcFailures) / 1000);
+}
+
+uint8_t RetryPolicy::failures() const {
+    return rtcFailures;
+}
+
+bool RetryPolicy::due() const {
+    return rtcFailures == 0 || time(nullptr) >= rtcRetryAt;
+}
+
+bool RetryPolicy::wantsConfig() const {
+    return rtcAuthFailures >= AUTH_FAILURES_FOR_CONFIG;
+}
+
+// 1, 2, 4 ... minutes, capped at an hour
+unsigned long RetryPolicy::backoffMs(uint8_t failures) {
+    unsigned long ms = RETRY_BASE_MS;
+    for (uint8_t i = 1; i < failures && ms < RETRY_MAX_MS; i++) ms *= 2;
+    return ms < RETRY_MAX_MS ? ms : RETRY_MAX_MS;
+}
+
+unsigned long RetryPolicy::sleepMs(unsigned long normalMs) const {
+    return rtcFailures == 0 ? normalMs : backoffMs(rtcFailures);
+}
@@ -0,0 +1,44 @@
+#ifndef RETRY_POLICY_H
+#define RETRY_POLICY_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// What went wrong on the last online attempt
+enum FailureKind : uint8_t {
+    FAIL_NETWORK,   // AP not reachable / connect timeout
+    FAIL_AUTH,      // AP rejected the credentials
+    FAIL_SERVER     // Online, but no usable data
+};
+
+const uint32_t WIFI_CONNECT_TIMEOUT_MS = 20000;      // Per wake, then back off
+const uint32_t RETRY_BASE_MS = 60UL * 1000;          // First retry after a failure
+const uint32_t RETRY_MAX_MS = 60UL * 60 * 1000;      // Backoff cap
+const uint8_t AUTH_FAILURES_FOR_CONFIG = 3;          // Rejected wakes in a row before config mode
+
+// Failure bookkeeping across deep sleep, with exponential backoff
+class RetryPolicy {
+public:
+    void begin();   // Hooks the WiFi disconnect reasons
+    void attemptStart() { _authRejected = false; } // Before WiFi.begin()
+
+    void success();
+    void failure(FailureKind kind);
+
+    uint8_t failures() const;
+    bool due() const;           // Backoff elapsed (or no failure), worth going online
+    bool authRejected() const { return _authRejected; }   // On this connect attempt
+    bool wantsConfig() const;   // Credentials rejected too often, the user has to fix them
+
+    // Sleep until the next attempt, `normalMs` while everything works
+    unsigned long sleepMs(unsigned long normalMs) const;
+
+private:
+    static volatile bool _authRejected;
+    static void onWiFiEvent(arduino_event_id_t event, arduino_event_info_t info);
+    static unsigned long backoffMs(uint8_t failures);
+};
+
+extern RetryPolicy retry;
+
+#endif
@@ -8,113 +8,355 @@
 #include "Settings.h"
 #include "WeAct_EInk.h"
 #include "LedManager.h"
+#include "Telemetry.h"
+#include "QrEncoder.h"
+#include "PowerManager.h"
+#include "RequestBudget.h"
+#include "WallClock.h"
+#include "DnsCache.h"
 
 // Fonts
 #include <Fonts/FreeMonoBold12pt7b.h>
 #include <Fonts/FreeMonoBold9pt7b.h>
 #include <Fonts/FreeMono9pt7b.h>
 
+#include "HttpJson.h"
 #include "WeatherUtils.h"
 #include "DisplayUtils.h"
 
 const char *SBB_URL_BASE = "https://transport.opendata.ch/v1/stationboard";
 
-void drawDepartures(JsonDocument &doc)
+extern uint32_t frameOnPanel; // RenderClient.h
+
+// Battery icon + charge + estimated days left, right-aligned so it ends at `right`
+void drawBatteryFooter(int right, int y)
+{
+    if (!power.hasBattery())
+        return;
+
+    char text[16];
+    float days = power.estimateDays(power.refreshMs(REFRESH_MS));
+    if (days >= 0)
+        snprintf(text, sizeof(text), "%d%% ~%dd", power.percent(), (int)(days + 0.5f));
+    else
+        snprintf(text, sizeof(text), "%d%%", power.percent());
+
+    int16_t x1, y1;
+    uint16_t w, h;
+    display.getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
+    int x = right - w;
+    display.setCursor(x, y);
+    display.print(text);
+
+    // 14x7 outline with a nub, filled by charge
+    int bx = x - 20;
+    display.drawRect(bx, y, 14, 7, EINK_BLACK);
+    display.fillRect(bx + 14, y + 2, 2, 3, EINK_BLACK);
+    display.fillRect(bx + 2, y + 2, power.percent() * 10 / 100, 3, EINK_BLACK);
+}
+
+// --- BOARD ---
+// Everything the departure screen shows, fetched before the radio goes down
+const int MAX_DEPARTURES = 8;
+
+struct Departure
+{
+    char time[6];  // "HH:MM"
+    int16_t delay; // Minutes
+    char line[12]; // Category + number, e.g. "IC5"
+    char dest[32]; // Already ASCII (utf8ToAscii)
+};
+
+struct Board
+{
+    Departure departures[MAX_DEPARTURES];
+    uint8_t count;
+    WeatherData weather;
+    time_t fetchedAt; // 0 = never
+};
+
+// --- LAYOUT ---
+// Columns and the weather corner are in pixels for the 400 px wide 4.2" panel
+// (the fonts do not scale); only the right edge and the row count follow the panel.
+const int HEADER_H = 45;
+const int WEATHER_W = 100;                        // Weather corner right of the red header
+const int ROW_TOP = 75;                           // Baseline of the first departure
+const int ROW_SPACING = 34;
+const int FOOTER_H = 12;                          // "Last Update" line
+const int COL_LINE = 100, COL_DEST = 160;         // Time column fits "HH:MM+99'"
+const int BOARD_ROWS = (EINK_HEIGHT - ROW_TOP - FOOTER_H) / ROW_SPACING + 1;
+static_assert(EINK_WIDTH >= 400, "The board layout is made for the 4.2\" panel");
+
+// Last good board, shown with a stale marker while offline
+RTC_DATA_ATTR Board cachedBoard = {};
+RTC_DATA_ATTR bool staleOnPanel = false;
+
+void drawBoard(const Board &board, bool stale)
 {
     display.clearBuffer();
 
     // Header
-    display.fillRect(0, 0, 300, 45, EINK_RED);
+    display.fillRect(0, 0, EINK_WIDTH - WEATHER_W, HEADER_H, EINK_RED);
     display.setFont(&FreeMonoBold12pt7b);
     display.setTextColor(EINK_WHITE);
-    display.setCursor(5, 35);
+    display.setCursor(5, HEADER_H - 10);
     display.println(utf8ToAscii(STATION_NAME));
 
-    // Weather Fetch & Header Info
-    double lat = doc["station"]["coordinate"]["x"]; // SBB API x is lat
-    double lon = doc["station"]["coordinate"]["y"]; // SBB API y is lon
-    WeatherData weather = fetchWeather(lat, lon);
-
-    if (weather.valid)
+    // Weather
+    if (board.weather.valid)
     {
-        drawWeatherSymbol(325, 22, weather.code);
+        drawWeatherSymbol(EINK_WIDTH - WEATHER_W + 25, HEADER_H / 2, board.weather.code);
         display.setFont(&FreeMonoBold9pt7b);
         display.setTextColor(EINK_BLACK);
-        display.setCursor(345, 30);
-        display.print(String(weather.temp, 1));
+        display.setCursor(EINK_WIDTH - WEATHER_W + 45, HEADER_H - 15);
+        display.print(String(board.weather.temp, 1));
         display.print("C");
     }
 
     // Connections
     display.setFont(&FreeMonoBold9pt7b);
     display.setTextColor(EINK_BLACK);
-    JsonArray board = doc["stationboard"];
-    int yPos = 75;        // Slightly higher start
-    int lineSpacing = 34; // Reduced from 35
+    int yPos = ROW_TOP;
 
-    if (board.size() == 0)
+    if (board.count == 0)
     {
         display.setCursor(5, yPos);
         display.println("No Data / API Error");
     }
     else
     {
-        for (JsonObject conn : board)
+        for (int i = 0; i < board.count && i < BOARD_ROWS; i++)
         {
-            String timeStr = String((const char *)conn["stop"]["departure"]).substring(11, 16);
-            int delay = conn["stop"]["delay"];
-            const char *cat = conn["category"];
-            const char *num = conn["number"];
-            const char *to = conn["to"];
-
+            const Departure &dep = board.departures[i];
             display.setCursor(5, yPos);
             display.setTextColor(EINK_BLACK);
-            display.print(timeStr);
+            display.print(dep.time);
 
-            if (delay > 0)
+            if (dep.delay > 0)
             {
-                display.setTextColor(EINK_RED);
+                // No red while partial refresh is preferred, partial updates only drive black/white
+                display.setTextColor(power.preferPartial() ? EINK_BLACK : EINK_RED);
                 display.print("+");
-                display.print(delay);
+                display.print(dep.delay);
                 display.print("'");
             }
 
             display.setTextColor(EINK_BLACK);
-            display.setCursor(100, yPos);
-            display.print(cat);
-            display.print(num);
+            display.setCursor(COL_LINE, yPos);
+            display.print(dep.line);
 
-            String dest = utf8ToAscii(String(to));
-            if (dest.length() > MAX_DEST_LEN)
-                dest = dest.substring(0, MAX_DEST_LEN);
-            display.setCursor(160, yPos);
-            display.print(dest);
+            display.setCursor(COL_DEST, yPos);
+            display.print(dep.dest);
 
-            yPos += lineSpacing;
+            yPos += ROW_SPACING;
         }
     }
 
-    // Timestamp (Bottom Right)
+    // Timestamp (Bottom Right), flagged when the board could not be refreshed
     struct tm timeinfo;
-    if (getLocalTime(&timeinfo))
+    if (board.fetchedAt > 0 && localtime_r(&board.fetchedAt, &timeinfo) && timeinfo.tm_year > 100)
     {
         display.setFont(NULL); // Smallest font
-        display.setTextColor(EINK_BLACK);
+        display.setTextColor(stale && !power.preferPartial() ? EINK_RED : EINK_BLACK);
         char updateStr[30];
-        sprintf(updateStr, "Last Update: %02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
+        sprintf(updateStr, stale ? "Stale since %02d:%02d" : "Last Update: %02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
         int16_t x1, y1;
         uint16_t w, h;
         display.getTextBounds(updateStr, 0, 0, &x1, &y1, &w, &h);
-        display.setCursor(400 - w - 5, 300 - h - 2);
+        display.setCursor(EINK_WIDTH - w - 5, EINK_HEIGHT - h - 2);
         display.print(updateStr);
+
+        display.setTextColor(EINK_BLACK);
+        drawBatteryFooter(EINK_WIDTH - w - 5 - 12, EINK_HEIGHT - h - 2);
     }
 }
 
-void fetchSBB()
+// Low battery: push the board and the weather corner as a partial update,
+// the red header does not change. Every few updates a full refresh clears ghosting.
+const EInkRect BOARD_RECTS[] = {{0, HEADER_H + 3, EINK_WIDTH, EINK_HEIGHT - HEADER_H - 3},
+                                 {EINK_WIDTH - WEATHER_W + 4, 0, WEATHER_W - 4, HEADER_H + 3}};
+const int BOARD_PARTIALS_BETWEEN_FULL = 5;
+RTC_DATA_ATTR uint8_t boardPartials = 0;
+
+// Red ink inside BOARD_RECTS after the last full refresh (delays, stale footer, weather icon).
+// A partial update cannot clear it, so it forces the next refresh to be full (unknown after power-on).
+RTC_DATA_ATTR bool boardRectsRed = true;
+
+bool redInBoardRects()
 {
-    Serial.println("Fetching SBB...");
-    if (WiFi.status() != WL_CONNECTED)
+    if (!display.redBuffer)
+        return false;
+    for (const EInkRect &r : BOARD_RECTS)
+        for (int y = r.y; y < r.y + r.h; y++)
+            for (int x = r.x / 8; x <= (r.x + r.w - 1) / 8; x++)
+                if (display.redBuffer[PanelGeometry::byteIndex(x * 8, y)])
+                    return true;
+    return false;
+}
+
+// The full refresh is only started, finishPanelRefresh() collects it
+bool refreshBoard()
+{
+    if (power.preferPartial() && !boardRectsRed && boardPartials < BOARD_PARTIALS_BETWEEN_FULL)
+    {
+        boardPartials++;
+        return display.displayPartial(BOARD_RECTS, 2);
+    }
+    boardPartials = 0;
+    boardRectsRed = redInBoardRects();
+    display.displayAsync();
+    return true;
+}
+
+// Board and thin client frames refresh while goToSleep() waits for a button
+// press. Whatever draws next, or powerDown(), has to collect them first so the
+// refresh phase ends at the BUSY edge and a timeout is still recorded.
+bool panelRefreshPending = false;
+
+void finishPanelRefresh()
+{
+    if (!panelRefreshPending)
         return;
+    panelRefreshPending = false;
+    if (!display.finishRefresh())
+        telemetry.setError(ERR_BUSY_TIMEOUT);
+    telemetry.phaseEnd(PHASE_REFRESH, display.refreshEndMs());
+}
+
+// Inverted "UPDATING..." badge over the "Last Update" line, pushed with a
+// partial refresh so a button press shows up within a fraction of a second.
+// It fully covers its window, so it works without the previous frame in RAM.
+const EInkRect UPDATING_BADGE = {EINK_WIDTH - 120, EINK_HEIGHT - 14, 120, 14};
+
+void drawUpdatingBadge()
+{
+    finishPanelRefresh();
+    display.fillRect(UPDATING_BADGE.x, UPDATING_BADGE.y, UPDATING_BADGE.w, UPDATING_BADGE.h, EINK_BLACK);
+    display.setFont(NULL);
+    display.setTextColor(EINK_WHITE);
+    display.setCursor(UPDATING_BADGE.x + (UPDATING_BADGE.w - 11 * 6) / 2, UPDATING_BADGE.y + 3);
+    display.print("UPDATING...");
+    display.displayPartial(&UPDATING_BADGE, 1);
+}
+
+// --- LAN BOARD CACHE ---
+// Optional upstream shared by several displays (Settings: Upstream URL), see
+// web-config/tools/board-cache-server.js. It gets `station` and `limit` like the
+// SBB API and answers with a fixed-size binary board (little-endian, no JSON):
+//   Header (16 bytes): "SBRD", u8 version, u8 count, u8 recordLen, u8 flags,
+//                      u32 fetchedAt (unix s), i16 temp (0.1 C), u8 weatherCode, u8 reserved
+//   count records of recordLen bytes, version 1 (52 bytes):
+//     char time[6] "HH:MM", i16 delay (min), char line[12], char dest[32] (UTF-8)
+// Strings are NUL padded. Longer records of later versions are read as a prefix.
+const uint8_t UPSTREAM_VERSION = 1;
+const uint8_t UPSTREAM_WEATHER = 0x01; // flags: temp / weatherCode are valid
+
+struct __attribute__((packed)) UpstreamHeader
+{
+    char magic[4];
+    uint8_t version;
+    uint8_t count;
+    uint8_t recordLen;
+    uint8_t flags;
+    uint32_t fetchedAt;
+    int16_t tempDeci;
+    uint8_t weatherCode;
+    uint8_t reserved;
+};
+
+struct __attribute__((packed)) UpstreamDeparture
+{
+    char time[6];
+    int16_t delay;
+    char line[12];
+    char dest[32];
+};
+
+static_assert(sizeof(UpstreamHeader) == 16 && sizeof(UpstreamDeparture) == 52, "Upstream board layout");
+
+bool readUpstreamBoard(Stream &in, Board &board)
+{
+    UpstreamHeader header;
+    if (in.readBytes((uint8_t *)&header, sizeof(header)) != sizeof(header) ||
+        memcmp(header.magic, "SBRD", 4) != 0 || header.version != UPSTREAM_VERSION ||
+        header.recordLen < sizeof(UpstreamDeparture))
+        return false;
+
+    board.count = 0;
+    uint8_t raw[255];
+    for (int i = 0; i < header.count; i++)
+    {
+        if (in.readBytes(raw, header.recordLen) != header.recordLen)
+            return false;
+        if (board.count == MAX_DEPARTURES)
+            continue;
+
+        UpstreamDeparture rec;
+        memcpy(&rec, raw, sizeof(rec));
+        rec.time[sizeof(rec.time) - 1] = 0;
+        rec.line[sizeof(rec.line) - 1] = 0;
+        rec.dest[sizeof(rec.dest) - 1] = 0;
+
+        Departure &dep = board.departures[board.count++];
+        strlcpy(dep.time, rec.time, sizeof(dep.time));
+        dep.delay = rec.delay;
+        strlcpy(dep.line, rec.line, sizeof(dep.line));
+        String dest = utf8ToAscii(String(rec.dest));
+        strlcpy(dep.dest, dest.c_str(), min((int)sizeof(dep.dest), MAX_DEST_LEN + 1));
+    }
+
+    bool weather = (header.flags & UPSTREAM_WEATHER) && power.allowWeather();
+    board.weather = {header.tempDeci / 10.0f, header.weatherCode, weather};
+    board.fetchedAt = header.fetchedAt;
+    return true;
+}
+
+// One small LAN request instead of the SBB and weather APIs
+bool fetchUpstreamBoard(Board &board)
+{
+    String q = STATION_NAME;
+    q.replace(" ", "%20");
+    String url = UPSTREAM_URL + (UPSTREAM_URL.indexOf('?') < 0 ? "?" : "&") + "station=" + q + "&limit=" + String(FETCH_LIMIT);
+    Serial.println("Fetching board cache: " + url);
+
+    WiFiClient plainClient;
+    WiFiClientSecure secureClient;
+    secureClient.setInsecure();
+    WiFiClient &client = UPSTREAM_URL.startsWith("https") ? secureClient : plainClient;
+    HTTPClient http;
+    if (!http.begin(client, url))
+        return false;
+
+    statusLed.setState(LED_UPDATING);
+    telemetry.phaseStart(PHASE_FETCH);
+    int httpCode = http.GET();
+    bool ok = httpCode == HTTP_CODE_OK && readUpstreamBoard(*http.getStreamPtr(), board);
+    if (!ok)
+    {
+        Serial.printf("Board cache failed (HTTP %d) -> SBB API\n", httpCode);
+    }
+    http.end();
+    telemetry.phaseEnd(PHASE_FETCH);
+    statusLed.setState(LED_OFF);
+    return ok;
+}
+
+// Stationboard plus weather, network only. False if the board could not be fetched.
+// A configured board cache is asked first, the SBB API is the fallback.
+bool fetchBoard(Board &board)
+{
+    board.fetchedAt = 0;
+    if (WiFi.status() != WL_CONNECTED)
+        return false;
+    if (UPSTREAM_URL.length() > 0 && fetchUpstreamBoard(board))
+        return true;
+    if (!budget.allow(API_SBB))
+    {
+        telemetry.setError(ERR_RATE_LIMITED);
+        return false;
+    }
+
+    Serial.println("Fetching SBB...");
 
     WiFiClientSecure client;
     client.setInsecure();
@@ -123,23 +365,115 @@ void fetchSBB()
     q.replace(" ", "%20");
     String url = String(SBB_URL_BASE) + "?station=" + q + "&limit=" + String(FETCH_LIMIT);
 
-    if (http.begin(client, url))
+    statusLed.setState(LED_UPDATING);
+    dnsCache.connect(client, url); // Times DNS and connect itself
+    if (!http.begin(client, url))
+    {
+        statusLed.setState(LED_OFF);
+        return false;
+    }
+
+    telemetry.phaseStart(PHASE_FETCH);
+    requestCompressed(http);
+    int httpCode = http.GET();
+    wallClock.fromHttpDate(http.header("Date")); // First boot: SNTP is usually still pending
+    budget.record(API_SBB, httpCode, http.header("Retry-After"));
+    bool ok = false;
+    double lat = 0, lon = 0;
+    if (httpCode == HTTP_CODE_OK)
     {
-        statusLed.setState(LED_UPDATING);
-        if (http.GET() == HTTP_CODE_OK)
+        JsonDocument doc;
+        DeserializationError err = deserializeResponse(http, doc, "SBB");
+        if (!err)
         {
-            String payload = http.getString();
-            JsonDocument doc;
-            if (!deserializeJson(doc, payload))
+            JsonArray departures = doc["stationboard"];
+            board.count = 0;
+            for (JsonObject conn : departures)
             {
-                drawDepartures(doc);
-                display.display(); // Always clean refresh for Timetable
-                Serial.println("Timetable Updated");
+                if (board.count == MAX_DEPARTURES)
+                    break;
+                Departure &dep = board.departures[board.count++];
+                const char *departure = conn["stop"]["departure"] | "";
+                strlcpy(dep.time, strlen(departure) >= 16 ? departure + 11 : "--:--", sizeof(dep.time));
+                dep.delay = conn["stop"]["delay"];
+                snprintf(dep.line, sizeof(dep.line), "%s%s", (const char *)(conn["category"] | ""), (const char *)(conn["number"] | ""));
+                String dest = utf8ToAscii(String((const char *)(conn["to"] | "")));
+                strlcpy(dep.dest, dest.c_str(), min((int)sizeof(dep.dest), MAX_DEST_LEN + 1));
             }
+            lat = doc["station"]["coordinate"]["x"]; // SBB API x is lat
+            lon = doc["station"]["coordinate"]["y"]; // SBB API y is lon
+            ok = true;
+        }
+        else
+        {
+            telemetry.setError(ERR_JSON);
         }
-        http.end();
-        statusLed.setState(LED_OFF);
     }
+    else
+    {
+        telemetry.setError(httpCode == HTTP_CODE_TOO_MANY_REQUESTS ? ERR_RATE_LIMITED : ERR_HTTP);
+        Serial.print("SBB HTTP Error: ");
+        Serial.println(httpCode);
+    }
+    http.end();
+    telemetry.phaseEnd(PHASE_FETCH);
+
+    board.weather = {0, 0, false};
+    if (ok && power.allowWeather()) // Skipped when the battery is low
+    {
+        if (budget.allow(API_WEATHER))
+            board.weather = fetchWeather(lat, lon);
+        else
+            board.weather = cachedBoard.weather; // Last known, rather than none
+    }
+
+    statusLed.setState(LED_OFF);
+    return ok;
+}
+
+// Draw and push, runs with the radio already off
+void showBoard(const Board &board, bool stale = false)
+{
+    finishPanelRefresh();
+    telemetry.phaseStart(PHASE_RENDER);
+    drawBoard(board, stale);
+    telemetry.phaseEnd(PHASE_RENDER);
+
+    telemetry.phaseStart(PHASE_REFRESH);
+    if (!refreshBoard()) // Clean refresh unless the battery asks for partial
+        telemetry.setError(ERR_BUSY_TIMEOUT);
+    panelRefreshPending = true;
+    frameOnPanel = 0; // Not the thin client's frame any more
+    Serial.println(stale ? "Stale timetable shown" : "Timetable Updated");
+}
+
+// Offline: mark the cached board as stale once, later failures leave the panel alone
+void showStaleBoard()
+{
+    if (staleOnPanel || cachedBoard.fetchedAt == 0)
+        return;
+    showBoard(cachedBoard, true);
+    staleOnPanel = true;
+}
+
+// Escape per the WIFI: URI scheme (\ ; , " : are special)
+String wifiQrPayload()
+{
+    auto escape = [](const String &in)
+    {
+        String out;
+        for (unsigned int i = 0; i < in.length(); i++)
+        {
+            char c = in[i];
+            if (c == '\\' || c == ';' || c == ',' || c == '"' || c == ':')
+                out += '\\';
+            out += c;
+        }
+        return out;
+    };
+    if (WIFI_PASS.length() == 0)
+        return "WIFI:T:nopass;S:" + escape(WIFI_SSID) + ";;";
+    return "WIFI:T:WPA;S:" + escape(WIFI_SSID) + ";P:" + escape(WIFI_PASS) + ";;";
 }
 
 void drawQRCodePage()
@@ -147,13 +481,16 @@ void drawQRCodePage()
     display.clearBuffer();
 
     // Header
-    display.fillRect(0, 0, 400, 45, EINK_RED);
+    display.fillRect(0, 0, EINK_WIDTH, HEADER_H, EINK_RED);
     display.setFont(&FreeMonoBold12pt7b);
     display.setTextColor(EINK_WHITE);
-    display.setCursor(10, 35);
+    display.setCursor(10, HEADER_H - 10);
     display.println("GUEST WLAN");
 
-    if (!WLAN_QR_ENABLED || WLAN_QR_SIZE <= 0)
+    // Built from the stored credentials, so it can never be out of date
+    static QrEncoder qr;
+    String payload = wifiQrPayload();
+    if (!WLAN_QR_ENABLED || WIFI_SSID.length() == 0 || !qr.encode((const uint8_t *)payload.c_str(), payload.length()))
     {
         display.setFont(&FreeMonoBold9pt7b);
         display.setTextColor(EINK_BLACK);
@@ -162,27 +499,30 @@ void drawQRCodePage()
         return;
     }
 
-    // Centering logic
-    int scale = 6; // Adjust scale for visibility
-    if (WLAN_QR_SIZE > 33)
-        scale = 4;
-
-    int qrTotalSize = WLAN_QR_SIZE * scale;
-    int startX = (400 - qrTotalSize) / 2;
-    int startY = 60 + (240 - qrTotalSize) / 2;
+    // Largest scale that leaves room for the SSID footer, start on a byte boundary
+    int areaH = EINK_HEIGHT - HEADER_H - 45;
+    int size = qr.size();
+    int scale = max(1, min(8, min(EINK_WIDTH - 20, areaH - 10) / size));
+    int qrTotalSize = size * scale;
+    int startX = ((EINK_WIDTH - qrTotalSize) / 2) & ~7;
+    int startY = HEADER_H + 10 + (areaH - qrTotalSize) / 2;
 
-    for (int y = 0; y < WLAN_QR_SIZE; y++)
+    // One span per run of dark modules
+    for (int y = 0; y < size; y++)
     {
-        for (int x = 0; x < WLAN_QR_SIZE; x++)
+        int x = 0;
+        while (x < size)
         {
-            int bitIdx = y * WLAN_QR_SIZE + x;
-            int byteIdx = bitIdx / 8;
-            int bitPos = 7 - (bitIdx % 8);
-
-            if (byteIdx < 256 && (WLAN_QR_BITMAP[byteIdx] & (1 << bitPos)))
+            if (!qr.module(x, y))
             {
-                display.fillRect(startX + x * scale, startY + y * scale, scale, scale, EINK_BLACK);
+                x++;
+                continue;
             }
+            int run = x;
+            while (run < size && qr.module(run, y))
+                run++;
+            display.fillRect(startX + x * scale, startY + y * scale, (run - x) * scale, scale, EINK_BLACK);
+            x = run;
         }
     }
 
@@ -1,5 +1,7 @@
 #include "Settings.h"
 #include <Preferences.h>
+#include <esp_rom_crc.h>
+#include <stddef.h>
 
 Preferences preferences;
 
@@ -10,84 +12,303 @@ String STATION_NAME = "Zuerich HB";
 int FETCH_LIMIT = 7;
 long REFRESH_MS = 7 * 60 * 1000;
 bool WLAN_QR_ENABLED = false;
-uint8_t WLAN_QR_BITMAP[256] = {0};
-int WLAN_QR_SIZE = 0;
+DisplayMode DISPLAY_MODE = MODE_DEPARTURES;
+String RENDER_URL = "";
+uint8_t CONFIG_TIMEOUT_MIN = 10;
+String UPSTREAM_URL = "";
 
 // Region / Pins
 const int MAX_DEST_LEN = 21;
 const char *TIMEZONE_STR = "CET-1CEST,M3.5.0/2,M10.5.0/3";
 
-void loadSettings()
+// --- PERSISTED SCHEMA ---
+// All settings live in one packed blob ("cfg") guarded by a CRC.
+// Bump SETTINGS_VERSION on layout changes and extend migrateRecord().
+const uint16_t SETTINGS_VERSION = 6;
+
+struct __attribute__((packed)) SettingsRecord
 {
-    preferences.begin("sbb_config", true); // Read-only mode = true
+    uint16_t version;
+    uint16_t length; // sizeof(SettingsRecord) at the time of writing
+    uint32_t crc;    // CRC32 of everything after this field
+    char ssid[33];
+    char pass[65];
+    char station[64];
+    uint16_t refreshMin;
+    uint8_t qrEnabled;
+    uint8_t displayMode; // v3
+    char renderUrl[128]; // v4
+    uint8_t configTimeoutMin; // v5
+    char upstreamUrl[128]; // v6
+};
+
+// Version 1 also carried the size of the uploaded QR bitmap
+struct __attribute__((packed)) SettingsRecordV1
+{
+    uint16_t version;
+    uint16_t length;
+    uint32_t crc;
+    char ssid[33];
+    char pass[65];
+    char station[64];
+    uint16_t refreshMin;
+    uint8_t qrEnabled;
+    uint8_t qrSize;
+};
+
+const size_t RECORD_HEADER_LEN = 8;
+
+// CRC of the record currently in flash, saves skip the write while it matches
+uint32_t persistedCrc = 0;
+
+static uint32_t recordCrc(const SettingsRecord &rec)
+{
+    return esp_rom_crc32_le(0, (const uint8_t *)&rec + RECORD_HEADER_LEN, sizeof(rec) - RECORD_HEADER_LEN);
+}
+
+static void copyField(char *dst, size_t size, const String &src)
+{
+    strlcpy(dst, src.c_str(), size);
+}
+
+static void recordFromGlobals(SettingsRecord &rec)
+{
+    memset(&rec, 0, sizeof(rec));
+    rec.version = SETTINGS_VERSION;
+    rec.length = sizeof(rec);
+    copyField(rec.ssid, sizeof(rec.ssid), WIFI_SSID);
+    copyField(rec.pass, sizeof(rec.pass), WIFI_PASS);
+    copyField(rec.station, sizeof(rec.station), STATION_NAME);
+    rec.refreshMin = REFRESH_MS / 60000;
+    rec.qrEnabled = WLAN_QR_ENABLED;
+    rec.displayMode = DISPLAY_MODE;
+    copyField(rec.renderUrl, sizeof(rec.renderUrl), RENDER_URL);
+    rec.configTimeoutMin = CONFIG_TIMEOUT_MIN;
+    copyField(rec.upstreamUrl, sizeof(rec.upstreamUrl), UPSTREAM_URL);
+    rec.crc = recordCrc(rec);
+}
+
+static void globalsFromRecord(const SettingsRecord &rec)
+{
+    WIFI_SSID = rec.ssid;
+    WIFI_PASS = rec.pass;
+    STATION_NAME = rec.station;
+    REFRESH_MS = (rec.refreshMin > 0 ? rec.refreshMin : 7) * 60 * 1000L;
+    WLAN_QR_ENABLED = rec.qrEnabled;
+    DISPLAY_MODE = (rec.displayMode == MODE_WATCHFACE) ? MODE_WATCHFACE : MODE_DEPARTURES;
+    RENDER_URL = rec.renderUrl;
+    CONFIG_TIMEOUT_MIN = rec.configTimeoutMin;
+    UPSTREAM_URL = rec.upstreamUrl;
+}
+
+// Version 0: one NVS key per setting (firmware before the packed record).
+// The keys are only removed once the record holding them is committed.
+static bool migrateLegacyKeys(SettingsRecord &rec)
+{
+    if (!preferences.isKey("ssid") && !preferences.isKey("station"))
+        return false;
 
-    // Load string with default backup
-    // Note: If keys don't exist, it returns the default value passed in 2nd arg
     WIFI_SSID = preferences.getString("ssid", WIFI_SSID);
     WIFI_PASS = preferences.getString("pass", WIFI_PASS);
     STATION_NAME = preferences.getString("station", STATION_NAME);
-
-    // Load Refresh time (stored in minutes to save space/logic complexity?)
-    int refresh_min = preferences.getInt("refresh_min", 7);
-    REFRESH_MS = refresh_min * 60 * 1000;
-
+    REFRESH_MS = preferences.getInt("refresh_min", 7) * 60 * 1000L;
     WLAN_QR_ENABLED = preferences.getBool("qr_enabled", false);
-    WLAN_QR_SIZE = preferences.getInt("qr_size", 0);
-    preferences.getBytes("qr_bitmap", WLAN_QR_BITMAP, 256);
+    recordFromGlobals(rec);
+    return true;
+}
 
+// Keys of older firmware (qr_bitmap: uploaded QR codes, no longer used)
+static void removeLegacyKeys()
+{
+    const char *legacy[] = {"ssid", "pass", "station", "refresh_min", "qr_enabled", "qr_size", "qr_bitmap"};
+    preferences.begin("sbb_config", false);
+    for (const char *key : legacy)
+        if (preferences.isKey(key))
+            preferences.remove(key);
     preferences.end();
+}
 
-    Serial.println("--- Loaded Settings ---");
-    Serial.println("SSID: " + WIFI_SSID);
-    Serial.println("Station: " + STATION_NAME);
-    Serial.println("Refresh: " + String(refresh_min) + " min");
-    Serial.println("-----------------------");
+static bool writeSettings();
+
+// Length of the records that only appended fields to the previous version
+static size_t appendedRecordLength(uint16_t version)
+{
+    switch (version)
+    {
+    case 2:
+        return offsetof(SettingsRecord, displayMode);
+    case 3:
+        return offsetof(SettingsRecord, renderUrl);
+    case 4:
+        return offsetof(SettingsRecord, configTimeoutMin);
+    case 5:
+        return offsetof(SettingsRecord, upstreamUrl);
+    default:
+        return 0;
+    }
 }
 
-void saveSettings(String new_ssid, String new_pass, String new_station, int new_refresh_min)
+// Upgrade an older record; fields it lacks keep their defaults
+static bool migrateRecord(const uint8_t *raw, size_t readLen, SettingsRecord &rec)
 {
-    preferences.begin("sbb_config", false); // Read-write
+    uint16_t version, length;
+    uint32_t crc;
+    if (readLen < RECORD_HEADER_LEN)
+        return false;
+    memcpy(&version, raw, 2);
+    memcpy(&length, raw + 2, 2);
+    memcpy(&crc, raw + 4, 4);
+    if (version > SETTINGS_VERSION || length != readLen)
+        return false;
+    if (esp_rom_crc32_le(0, raw + RECORD_HEADER_LEN, readLen - RECORD_HEADER_LEN) != crc)
+        return false;
 
-    if (new_ssid.length() > 0)
+    if (version == 1 && readLen == sizeof(SettingsRecordV1))
     {
-        preferences.putString("ssid", new_ssid);
-        WIFI_SSID = new_ssid;
+        // The QR code is now generated on the device, the bitmap size is dropped
+        SettingsRecordV1 v1;
+        memcpy(&v1, raw, sizeof(v1));
+        memcpy(rec.ssid, v1.ssid, sizeof(rec.ssid));
+        memcpy(rec.pass, v1.pass, sizeof(rec.pass));
+        memcpy(rec.station, v1.station, sizeof(rec.station));
+        rec.refreshMin = v1.refreshMin;
+        rec.qrEnabled = v1.qrEnabled;
+        version = 2;
     }
-    if (new_pass.length() > 0)
+    else if (version >= 2 && version < SETTINGS_VERSION && readLen == appendedRecordLength(version))
     {
-        preferences.putString("pass", new_pass);
-        WIFI_PASS = new_pass;
+        // Later versions only append fields, older records are a prefix
+        memcpy(&rec, raw, readLen);
     }
-    if (new_station.length() > 0)
+    else if (version == SETTINGS_VERSION && readLen == sizeof(rec))
     {
-        preferences.putString("station", new_station);
-        STATION_NAME = new_station;
+        memcpy(&rec, raw, sizeof(rec));
     }
-    if (new_refresh_min > 0)
+
+    if (version == 2)
     {
-        preferences.putInt("refresh_min", new_refresh_min);
-        REFRESH_MS = new_refresh_min * 60 * 1000;
+        rec.displayMode = MODE_DEPARTURES;
+        version = 3;
     }
-
-    // Invalidation logic: if SSID or Pass actually changed
-    if ((new_ssid.length() > 0 && new_ssid != WIFI_SSID) ||
-        (new_pass.length() > 0 && new_pass != WIFI_PASS))
+    if (version == 3)
+    {
+        rec.renderUrl[0] = 0; // Thin client off
+        version = 4;
+    }
+    if (version == 4)
     {
-        WLAN_QR_ENABLED = false;
-        preferences.putBool("qr_enabled", false);
-        Serial.println("WLAN Settings changed -> QR Code Invalidated");
+        rec.configTimeoutMin = CONFIG_TIMEOUT_MIN;
+        version = 5;
     }
+    if (version == 5)
+    {
+        rec.upstreamUrl[0] = 0; // SBB API directly
+        version = 6;
+    }
+
+    return version == SETTINGS_VERSION;
+}
+
+void loadSettings()
+{
+    SettingsRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    bool valid = false;
+    bool migrated = false;
 
+    // Single NVS read on the normal path; sized for the largest known layout
+    uint8_t raw[sizeof(SettingsRecordV1) > sizeof(SettingsRecord) ? sizeof(SettingsRecordV1) : sizeof(SettingsRecord)];
+    preferences.begin("sbb_config", true); // Read-only mode = true
+    size_t readLen = preferences.getBytes("cfg", raw, sizeof(raw));
     preferences.end();
-    Serial.println("Settings Saved to NVS");
+
+    if (readLen > 0)
+    {
+        valid = migrateRecord(raw, readLen, rec);
+        migrated = valid && ((SettingsRecord *)raw)->version != SETTINGS_VERSION;
+        if (!valid)
+            Serial.println("Settings record invalid -> Defaults");
+    }
+
+    if (valid)
+    {
+        // Ensure strings are terminated even if the blob was tampered with
+        rec.ssid[sizeof(rec.ssid) - 1] = 0;
+        rec.pass[sizeof(rec.pass) - 1] = 0;
+        rec.station[sizeof(rec.station) - 1] = 0;
+        rec.renderUrl[sizeof(rec.renderUrl) - 1] = 0;
+        rec.upstreamUrl[sizeof(rec.upstreamUrl) - 1] = 0;
+        globalsFromRecord(rec);
+    }
+    else if (readLen == 0)
+    {
+        preferences.begin("sbb_config", false);
+        migrated = migrateLegacyKeys(rec);
+        preferences.end();
+        if (migrated)
+            Serial.println("Migrated legacy settings keys");
+    }
+
+    persistedCrc = settingsCrc();
+    // Write the upgraded record even though it matches the globals, and drop
+    // the old keys only once it is in flash (a power loss in between just
+    // migrates again on the next boot)
+    if (migrated && writeSettings())
+        removeLegacyKeys();
+
+    Serial.println("--- Loaded Settings ---");
+    Serial.println("SSID: " + WIFI_SSID);
+    Serial.println("Station: " + STATION_NAME);
+    Serial.println("Refresh: " + String(REFRESH_MS / 60000) + " min");
+    Serial.println("-----------------------");
 }
 
-void saveWLANQR()
+uint32_t settingsCrc()
 {
-    preferences.begin("sbb_config", false);
-    preferences.putBool("qr_enabled", WLAN_QR_ENABLED);
-    preferences.putInt("qr_size", WLAN_QR_SIZE);
-    preferences.putBytes("qr_bitmap", WLAN_QR_BITMAP, 256);
+    SettingsRecord rec;
+    recordFromGlobals(rec);
+    return rec.crc;
+}
+
+// The CRC covers every field, so comparing it is enough
+bool settingsChanged()
+{
+    return settingsCrc() != persistedCrc;
+}
+
+bool commitSettings()
+{
+    if (!settingsChanged())
+    {
+        Serial.println("Settings unchanged -> No NVS write");
+        return true;
+    }
+    return writeSettings();
+}
+
+static bool writeSettings()
+{
+    SettingsRecord rec;
+    recordFromGlobals(rec);
+    preferences.begin("sbb_config", false); // Read-write
+    bool ok = preferences.putBytes("cfg", &rec, sizeof(rec)) == sizeof(rec);
     preferences.end();
-    Serial.println("WLAN QR Saved to NVS");
+    if (ok)
+        persistedCrc = rec.crc;
+    Serial.println(ok ? "Settings Saved to NVS" : "Settings NVS write FAILED");
+    return ok;
+}
+
+void saveSettings(String new_ssid, String new_pass, String new_station, int new_refresh_min)
+{
+    if (new_ssid.length() > 0)
+        WIFI_SSID = new_ssid;
+    if (new_pass.length() > 0)
+        WIFI_PASS = new_pass;
+    if (new_station.length() > 0)
+        STATION_NAME = new_station;
+    if (new_refresh_min > 0)
+        REFRESH_MS = new_refresh_min * 60 * 1000L;
+
+    commitSettings();
 }
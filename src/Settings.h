@@ -13,21 +13,40 @@ extern int FETCH_LIMIT;
 extern long REFRESH_MS;
 
 // WLAN QR Code Settings
-extern bool WLAN_QR_ENABLED;
-extern uint8_t WLAN_QR_BITMAP[256];
-extern int WLAN_QR_SIZE; // Actual size (e.g. 33 for 33x33)
+extern bool WLAN_QR_ENABLED; // QR itself is generated from WIFI_SSID / WIFI_PASS
+
+// What the device shows between wakes
+enum DisplayMode : uint8_t
+{
+    MODE_DEPARTURES = 0, // Stationboard, wakes every REFRESH_MS
+    MODE_WATCHFACE = 1   // Clock, wakes on minute boundaries
+};
+extern DisplayMode DISPLAY_MODE;
+
+// Thin client: fetch pre-rendered frames from a LAN render service (empty = off)
+extern String RENDER_URL;
+
+// Config mode leaves on its own after this many idle minutes (0 = never)
+extern uint8_t CONFIG_TIMEOUT_MIN;
+
+// LAN board cache shared by several displays, replaces the SBB API (empty = direct)
+extern String UPSTREAM_URL;
 
 extern const int MAX_DEST_LEN;
 
 // --- FUNCTIONS ---
 void loadSettings();
 void saveSettings(String new_ssid, String new_pass, String new_station, int new_refresh_min);
-void saveWLANQR(); // Save QR specific settings
+bool settingsChanged();       // Differs from the record stored in NVS
+bool commitSettings();        // Rewrite the record, only if it changed
+uint32_t settingsCrc();       // Changes whenever any setting does
 
 
 // --- PINS (ESP32-S3 SuperMini Right-Side Cluster) ---
 const int PIN_RGB_LED = 48; // Built-in RGB LED (WS2812) on SuperMini
+const int PIN_LED_POWER = -1; // Optional high-side switch for the LED rail (-1 = always powered)
 const int PIN_TOUCH = 10;
+const int PIN_BATTERY_ADC = 1; // Battery + via 1:2 divider (ADC1_CH0, RTC capable)
 
 const int PIN_EINK_BUSY = 4;
 const int PIN_EINK_CS = 5;
@@ -36,6 +55,10 @@ const int PIN_EINK_RST = 16;
 const int PIN_EINK_DC = 17;
 const int PIN_EINK_CLK = 18;
 
+// --- BATTERY ---
+const float BATTERY_DIVIDER = 2.0f;     // Resistor divider on PIN_BATTERY_ADC
+const int BATTERY_CAPACITY_MAH = 1200;  // Used for the remaining-days estimate
+
 // --- REGION ---
 extern const char *TIMEZONE_STR;
 
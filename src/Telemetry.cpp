@@ -0,0 +1,119 @@
+#include "Telemetry.h"
+#include <esp_sleep.h>
+
+Telemetry telemetry;
+
+// History survives deep sleep (lost on power cycle / reset)
+RTC_DATA_ATTR WakeRecord rtcHistory[TELEMETRY_HISTORY];
+RTC_DATA_ATTR uint8_t rtcHistoryHead = 0;
+RTC_DATA_ATTR uint8_t rtcHistoryCount = 0;
+RTC_DATA_ATTR uint32_t rtcWakeCount = 0;
+RTC_DATA_ATTR uint8_t rtcLastError = ERR_NONE;
+
+void Telemetry::beginCycle() {
+    memset(&_current, 0, sizeof(_current));
+    memset(_phaseStart, 0, sizeof(_phaseStart));
+    _radioStart = 0;
+    _current.wakeReason = (uint8_t)esp_sleep_get_wakeup_cause();
+    rtcWakeCount++;
+}
+
+void Telemetry::phaseStart(TelemetryPhase phase) {
+    _phaseStart[phase] = millis();
+}
+
+void Telemetry::phaseEnd(TelemetryPhase phase) {
+    phaseEnd(phase, millis());
+}
+
+void Telemetry::phaseEnd(TelemetryPhase phase, unsigned long endMs) {
+    // Phases may run more than once per cycle (e.g. manual refresh), so accumulate
+    uint32_t total = _current.phaseMs[phase] + (endMs - _phaseStart[phase]);
+    _current.phaseMs[phase] = (total > 0xFFFF) ? 0xFFFF : (uint16_t)total;
+}
+
+void Telemetry::radioStart() {
+    if (_radioStart == 0) _radioStart = millis() | 1;
+}
+
+void Telemetry::radioEnd() {
+    if (_radioStart == 0) return;
+    uint32_t total = _current.radioMs + (millis() - _radioStart);
+    _current.radioMs = (total > 0xFFFF) ? 0xFFFF : (uint16_t)total;
+    _radioStart = 0;
+}
+
+void Telemetry::setError(TelemetryError error) {
+    _current.error = error;
+    rtcLastError = error;
+}
+
+void Telemetry::setBatteryMv(uint16_t mv) {
+    _current.batteryMv = mv;
+}
+
+void Telemetry::endCycle() {
+    radioEnd(); // Still up if the cycle ended on a network path
+    _current.totalMs = millis();
+    rtcHistory[rtcHistoryHead] = _current;
+    rtcHistoryHead = (rtcHistoryHead + 1) % TELEMETRY_HISTORY;
+    if (rtcHistoryCount < TELEMETRY_HISTORY) rtcHistoryCount++;
+}
+
+bool Telemetry::averageCycle(WakeRecord &avg) const {
+    memset(&avg, 0, sizeof(avg));
+    if (rtcHistoryCount == 0) return false;
+
+    uint32_t total = 0;
+    uint32_t phases[PHASE_COUNT] = {0};
+    for (int i = 0; i < rtcHistoryCount; i++) {
+        total += rtcHistory[i].totalMs;
+        for (int ph = 0; ph < PHASE_COUNT; ph++) phases[ph] += rtcHistory[i].phaseMs[ph];
+    }
+    avg.totalMs = total / rtcHistoryCount;
+    for (int ph = 0; ph < PHASE_COUNT; ph++) avg.phaseMs[ph] = phases[ph] / rtcHistoryCount;
+    return true;
+}
+
+// --- Wire format (little-endian) ---
+// Header (28 bytes):
+//   u8 version, u8 phaseCount, u8 recordCount, u8 lastError,
+//   u32 wakeCount, u32 uptimeMs,
+//   u32 freeHeap, u32 minFreeHeap, u32 maxAllocHeap, u32 freePsram
+// Records, newest first (10 + 2 * phaseCount bytes each):
+//   u32 totalMs, u16 phaseMs[phaseCount], u16 batteryMv, u8 wakeReason, u8 error,
+//   u16 radioMs (version 2)
+static uint8_t *put8(uint8_t *p, uint8_t v) { *p++ = v; return p; }
+static uint8_t *put16(uint8_t *p, uint16_t v) { *p++ = v; *p++ = v >> 8; return p; }
+static uint8_t *put32(uint8_t *p, uint32_t v) { p = put16(p, v); return put16(p, v >> 16); }
+
+size_t Telemetry::serialize(uint8_t *out, size_t maxLen) {
+    if (maxLen < TELEMETRY_HEADER_LEN) return 0;
+
+    // Only send as many records as fit (notifications are capped by the MTU)
+    size_t records = (maxLen - TELEMETRY_HEADER_LEN) / TELEMETRY_RECORD_LEN;
+    if (records > rtcHistoryCount) records = rtcHistoryCount;
+
+    uint8_t *p = out;
+    p = put8(p, TELEMETRY_FORMAT_VERSION);
+    p = put8(p, PHASE_COUNT);
+    p = put8(p, (uint8_t)records);
+    p = put8(p, rtcLastError);
+    p = put32(p, rtcWakeCount);
+    p = put32(p, millis());
+    p = put32(p, ESP.getFreeHeap());
+    p = put32(p, ESP.getMinFreeHeap());
+    p = put32(p, ESP.getMaxAllocHeap());
+    p = put32(p, ESP.getFreePsram());
+
+    for (size_t i = 0; i < records; i++) {
+        const WakeRecord &r = rtcHistory[(rtcHistoryHead + TELEMETRY_HISTORY - 1 - i) % TELEMETRY_HISTORY];
+        p = put32(p, r.totalMs);
+        for (int ph = 0; ph < PHASE_COUNT; ph++) p = put16(p, r.phaseMs[ph]);
+        p = put16(p, r.batteryMv);
+        p = put8(p, r.wakeReason);
+        p = put8(p, r.error);
+        p = put16(p, r.radioMs);
+    }
+    return p - out;
+}
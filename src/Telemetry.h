@@ -0,0 +1,74 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+// Phases of a wake cycle that get timed individually
+enum TelemetryPhase {
+    PHASE_WIFI,     // WiFi association
+    PHASE_FETCH,    // HTTP + JSON (SBB and weather)
+    PHASE_RENDER,   // Drawing into the framebuffers
+    PHASE_REFRESH,  // SPI push + panel BUSY wait
+    PHASE_DNS,      // Host lookups the DNS cache could not answer
+    PHASE_COUNT
+};
+
+enum TelemetryError : uint8_t {
+    ERR_NONE = 0,
+    ERR_WIFI_TIMEOUT,
+    ERR_HTTP,
+    ERR_JSON,
+    ERR_BUSY_TIMEOUT,
+    ERR_FRAME,      // Thin client frame malformed / hash mismatch
+    ERR_WIFI_AUTH,  // AP rejected the credentials
+    ERR_RATE_LIMITED // API answered 429 or today's request budget is used up
+};
+
+// Number of wake cycles kept in RTC memory
+const int TELEMETRY_HISTORY = 8;
+
+// Wire format version of the diagnostics characteristic
+const uint8_t TELEMETRY_FORMAT_VERSION = 2;
+
+// Serialized sizes (see Telemetry.cpp), a full snapshot holds the whole history
+const size_t TELEMETRY_HEADER_LEN = 28;
+const size_t TELEMETRY_RECORD_LEN = 10 + 2 * PHASE_COUNT;
+const size_t TELEMETRY_MAX_LEN = TELEMETRY_HEADER_LEN + TELEMETRY_HISTORY * TELEMETRY_RECORD_LEN;
+
+// One wake cycle, kept across deep sleep
+struct WakeRecord {
+    uint32_t totalMs;
+    uint16_t phaseMs[PHASE_COUNT];
+    uint16_t batteryMv;   // 0 = not measured
+    uint8_t wakeReason;   // esp_sleep_wakeup_cause_t
+    uint8_t error;        // TelemetryError
+    uint16_t radioMs;     // WiFi up, overlaps PHASE_WIFI / PHASE_FETCH
+};
+
+class Telemetry {
+public:
+    void beginCycle();
+    void phaseStart(TelemetryPhase phase);
+    void phaseEnd(TelemetryPhase phase);
+    void phaseEnd(TelemetryPhase phase, unsigned long endMs); // Ended earlier than now
+    void radioStart();
+    void radioEnd();
+    void setError(TelemetryError error);
+    void setBatteryMv(uint16_t mv);
+    void endCycle(); // Commit the current cycle into the history ring
+
+    // Mean of the recorded cycles (phases and total), false if there is no history yet
+    bool averageCycle(WakeRecord &avg) const;
+
+    // Compact little-endian snapshot for BLE, returns bytes written
+    size_t serialize(uint8_t *out, size_t maxLen);
+
+private:
+    WakeRecord _current;
+    unsigned long _phaseStart[PHASE_COUNT];
+    unsigned long _radioStart;   // 0 = radio off
+};
+
+extern Telemetry telemetry;
+
+#endif
@@ -0,0 +1,145 @@
+#include "UlpSupervisor.h"
+#include "ButtonInput.h"
+#include <esp_sleep.h>
+
+UlpSupervisor ulp;
+
+#if ULP_SUPERVISOR_AVAILABLE
+
+#include <esp32s3/ulp.h>
+#include <driver/rtc_io.h>
+#include <driver/adc.h>
+#include <soc/rtc_cntl_reg.h>
+#include <soc/rtc_io_reg.h>
+
+// --- RTC slow memory layout (32 bit words, the ULP uses the low 16 bits) ---
+enum UlpVar {
+    VAR_EVENT = 0,          // UlpEvent, written right before waking the SoC
+    VAR_PRESS_TICKS,        // Ticks the button has been held
+    VAR_BATTERY_RAW,        // Last ADC1 sample
+    VAR_BATTERY_LOW_RAW,    // Wake threshold, 0 = off
+    VAR_SAMPLE_COUNTDOWN,   // Ticks until the next ADC sample
+    PROGRAM_START = 8
+};
+
+enum UlpLabel {
+    L_RELEASED,
+    L_LONG,
+    L_BATTERY,
+    L_COUNTDOWN,
+    L_LOW,
+    L_WAKE
+};
+
+const uint32_t DEBOUNCE_TICKS = BUTTON_DEBOUNCE_MS / ULP_TICK_MS;
+const uint32_t LONG_TICKS = BUTTON_LONG_MS / ULP_TICK_MS;
+const uint32_t VERY_LONG_TICKS = BUTTON_VERY_LONG_MS / ULP_TICK_MS;
+
+static uint16_t ulpVar(UlpVar var) {
+    return RTC_SLOW_MEM[var] & 0xFFFF;
+}
+
+void UlpSupervisor::begin() {
+    // Keep the program from waking us again while we are up
+    CLEAR_PERI_REG_MASK(RTC_CNTL_ULP_CP_TIMER_REG, RTC_CNTL_ULP_CP_SLP_TIMER_EN);
+
+    if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_ULP) {
+        _wakeEvent = (UlpEvent)ulpVar(VAR_EVENT);
+        _batteryRaw = ulpVar(VAR_BATTERY_RAW);
+    }
+    RTC_SLOW_MEM[VAR_EVENT] = ULP_EVENT_NONE;
+
+    // Hand the button back to the digital GPIO matrix
+    rtc_gpio_deinit((gpio_num_t)PIN_TOUCH);
+}
+
+bool UlpSupervisor::arm(uint16_t batteryLowRaw) {
+    const int buttonIo = rtc_io_number_get((gpio_num_t)PIN_TOUCH);
+    const int batteryChannel = digitalPinToAnalogChannel(PIN_BATTERY_ADC);
+    if (buttonIo < 0 || batteryChannel < 0) return false;
+
+    rtc_gpio_init((gpio_num_t)PIN_TOUCH);
+    rtc_gpio_set_direction((gpio_num_t)PIN_TOUCH, RTC_GPIO_MODE_INPUT_ONLY);
+
+    adc1_config_width(ADC_WIDTH_BIT_12);
+    adc1_config_channel_atten((adc1_channel_t)batteryChannel, ADC_ATTEN_DB_11);
+    adc1_ulp_enable();
+
+    // R3 holds 0 as base address for all variables
+    const ulp_insn_t program[] = {
+        I_MOVI(R3, 0),
+
+        // --- Button: count ticks while held, decode on release ---
+        I_RD_REG(RTC_GPIO_IN_REG, RTC_GPIO_IN_NEXT_S + buttonIo, RTC_GPIO_IN_NEXT_S + buttonIo),
+        M_BL(L_RELEASED, 1),
+        I_LD(R0, R3, VAR_PRESS_TICKS),
+        I_ADDI(R0, R0, 1),
+        I_ST(R0, R3, VAR_PRESS_TICKS),
+        M_BL(L_BATTERY, VERY_LONG_TICKS),
+        I_MOVI(R0, ULP_EVENT_VERY_LONG),
+        M_BX(L_WAKE),
+
+        M_LABEL(L_RELEASED),
+        I_LD(R0, R3, VAR_PRESS_TICKS),
+        I_MOVI(R1, 0),
+        I_ST(R1, R3, VAR_PRESS_TICKS),
+        M_BL(L_BATTERY, DEBOUNCE_TICKS + 1), // Idle or a bounce: no wakeup
+        M_BGE(L_LONG, LONG_TICKS + 1),
+        I_MOVI(R0, ULP_EVENT_SHORT),
+        M_BX(L_WAKE),
+        M_LABEL(L_LONG),
+        I_MOVI(R0, ULP_EVENT_LONG),
+        M_BX(L_WAKE),
+
+        // --- Battery: one sample every ULP_BATTERY_EVERY_TICKS ---
+        M_LABEL(L_BATTERY),
+        I_LD(R0, R3, VAR_SAMPLE_COUNTDOWN),
+        M_BGE(L_COUNTDOWN, 1),
+        I_MOVI(R0, ULP_BATTERY_EVERY_TICKS),
+        I_ST(R0, R3, VAR_SAMPLE_COUNTDOWN),
+        I_ADC(R0, 0, batteryChannel),
+        I_ST(R0, R3, VAR_BATTERY_RAW),
+        I_LD(R1, R3, VAR_BATTERY_LOW_RAW),
+        I_SUBR(R0, R0, R1), // Overflows if sample < threshold
+        M_BXF(L_LOW),
+        I_HALT(),
+        M_LABEL(L_LOW),
+        I_MOVI(R0, ULP_EVENT_BATTERY_LOW),
+        M_BX(L_WAKE),
+
+        M_LABEL(L_COUNTDOWN),
+        I_SUBI(R0, R0, 1),
+        I_ST(R0, R3, VAR_SAMPLE_COUNTDOWN),
+        I_HALT(),
+
+        M_LABEL(L_WAKE),
+        I_ST(R0, R3, VAR_EVENT),
+        I_WAKE(),
+        I_HALT(),
+    };
+
+    RTC_SLOW_MEM[VAR_EVENT] = ULP_EVENT_NONE;
+    RTC_SLOW_MEM[VAR_PRESS_TICKS] = 0;
+    RTC_SLOW_MEM[VAR_BATTERY_RAW] = 0;
+    RTC_SLOW_MEM[VAR_BATTERY_LOW_RAW] = batteryLowRaw;
+    RTC_SLOW_MEM[VAR_SAMPLE_COUNTDOWN] = 0; // Sample right away
+
+    size_t size = sizeof(program) / sizeof(ulp_insn_t);
+    if (ulp_process_macros_and_load(PROGRAM_START, program, &size) != ESP_OK) return false;
+    ulp_set_wakeup_period(0, ULP_TICK_MS * 1000);
+    if (ulp_run(PROGRAM_START) != ESP_OK) return false;
+
+    esp_sleep_enable_ulp_wakeup();
+    return true;
+}
+
+#else
+
+void UlpSupervisor::begin() {
+}
+
+bool UlpSupervisor::arm(uint16_t batteryLowRaw) {
+    return false;
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef ULP_SUPERVISOR_H
+#define ULP_SUPERVISOR_H
+
+#include <Arduino.h>
+#include "Settings.h"
+
+// The ULP-FSM can only be loaded when the core's sdkconfig reserves RTC slow
+// memory for it. Without it we fall back to the plain EXT1 button wakeup.
+#if (defined(CONFIG_ESP32S3_ULP_COPROC_ENABLED) && !defined(CONFIG_ESP32S3_ULP_COPROC_RISCV)) || \
+    defined(CONFIG_ULP_COPROC_TYPE_FSM)
+#define ULP_SUPERVISOR_AVAILABLE 1
+#else
+#define ULP_SUPERVISOR_AVAILABLE 0
+#endif
+
+// What made the ULP wake the main cores
+enum UlpEvent : uint8_t {
+    ULP_EVENT_NONE = 0,
+    ULP_EVENT_SHORT,        // Button released after the debounce time
+    ULP_EVENT_LONG,         // Button released after BUTTON_LONG_MS
+    ULP_EVENT_VERY_LONG,    // Button still held at BUTTON_VERY_LONG_MS
+    ULP_EVENT_BATTERY_LOW   // Battery sample below the armed threshold
+};
+
+const uint32_t ULP_TICK_MS = 10;            // Program period while asleep
+const uint32_t ULP_BATTERY_EVERY_TICKS = 6000; // One ADC sample per minute
+const uint16_t ULP_BATTERY_LOW_RAW = 2245;     // ~3.4 V through the 1:2 divider (11 dB, uncalibrated)
+const uint16_t ULP_BATTERY_HYSTERESIS_RAW = 100;
+
+class UlpSupervisor {
+public:
+    // On boot: fetch the event that woke us and stop the program
+    void begin();
+    // Load and start the program before deep sleep, false if no ULP is available.
+    // batteryLowRaw = 0 disables the battery threshold.
+    bool arm(uint16_t batteryLowRaw);
+
+    UlpEvent wakeEvent() const { return _wakeEvent; }
+    uint16_t batteryRaw() const { return _batteryRaw; } // Last sample taken while asleep, 0 = none
+
+private:
+    UlpEvent _wakeEvent = ULP_EVENT_NONE;
+    uint16_t _batteryRaw = 0;
+};
+
+extern UlpSupervisor ulp;
+
+#endif
@@ -0,0 +1,120 @@
+#include "WallClock.h"
+#include <esp_sntp.h>
+#include <time.h>
+#include "Settings.h"
+
+WallClock wallClock;
+
+// Survive deep sleep (lost on power cycle / reset, the clock is then invalid anyway)
+RTC_DATA_ATTR time_t rtcLastSync = 0;      // Last SNTP sync, 0 = none
+RTC_DATA_ATTR time_t rtcCorrectedAt = 0;   // Drift is corrected up to this time
+RTC_DATA_ATTR int32_t rtcDriftPpm = 0;     // + = RTC runs slow
+
+static int64_t toUs(const struct timeval &tv) {
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+void WallClock::step(int64_t deltaUs) {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    int64_t us = toUs(tv) + deltaUs;
+    tv.tv_sec = us / 1000000;
+    tv.tv_usec = us % 1000000;
+    settimeofday(&tv, nullptr);
+}
+
+void WallClock::begin() {
+    time_t now = time(nullptr);
+    if (!valid() || rtcCorrectedAt == 0 || rtcDriftPpm == 0) return;
+    if (now < rtcCorrectedAt) {
+        rtcCorrectedAt = now;
+        return;
+    }
+
+    // Seconds times ppm is microseconds
+    int64_t correctionUs = (int64_t)(now - rtcCorrectedAt) * rtcDriftPpm;
+    if (llabs(correctionUs) < CLOCK_MIN_STEP_US) return;
+    step(correctionUs);
+    rtcCorrectedAt = time(nullptr);
+}
+
+bool WallClock::valid() const {
+    return time(nullptr) >= CLOCK_VALID_AFTER;
+}
+
+bool WallClock::syncDue() const {
+    return rtcLastSync == 0 || time(nullptr) - rtcLastSync > CLOCK_SYNC_INTERVAL_S;
+}
+
+time_t WallClock::lastSync() const {
+    return rtcLastSync;
+}
+
+// Runs in the lwIP task, after SNTP has set the time
+void WallClock::onSync(struct timeval *tv) {
+    WallClock &c = wallClock;
+    if (c._measure && rtcLastSync != 0) {
+        int64_t estimateUs = toUs(c._startWall) + (int64_t)(micros() - c._startMicros);
+        int64_t sinceSync = estimateUs / 1000000 - rtcLastSync;
+        if (sinceSync >= CLOCK_DRIFT_MIN_S) {
+            // What the current correction still missed, added onto it
+            int32_t ppm = rtcDriftPpm + (int32_t)((toUs(*tv) - estimateUs) / sinceSync);
+            rtcDriftPpm = constrain(ppm, -CLOCK_DRIFT_MAX_PPM, CLOCK_DRIFT_MAX_PPM);
+            Serial.printf("SNTP: off by %lld ms after %llds, drift now %ld ppm\n",
+                          (long long)((toUs(*tv) - estimateUs) / 1000), (long long)sinceSync, (long)rtcDriftPpm);
+        }
+    }
+    rtcLastSync = tv->tv_sec;
+    rtcCorrectedAt = tv->tv_sec;
+    c._synced = true;
+}
+
+void WallClock::startSync() {
+    _synced = false;
+    _measure = valid();
+    gettimeofday(&_startWall, nullptr);
+    _startMicros = micros();
+    sntp_set_time_sync_notification_cb(onSync);
+    configTzTime(TIMEZONE_STR, "pool.ntp.org"); // Keeps our TZ, configTime() would reset it
+}
+
+void WallClock::stopSync() {
+    if (sntp_enabled()) sntp_stop();
+}
+
+bool WallClock::waitSync(uint32_t timeoutMs) {
+    unsigned long start = millis();
+    while (!_synced && millis() - start < timeoutMs) delay(50);
+    return _synced;
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date (m 1..12)
+static int64_t daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return (int64_t)era * 146097 + doe - 719468;
+}
+
+void WallClock::fromHttpDate(const String &date) {
+    if (_synced || date.length() == 0) return;
+
+    char monthName[4];
+    int day, year, hour, minute, second;
+    if (sscanf(date.c_str(), "%*3s, %d %3s %d %d:%d:%d", &day, monthName, &year, &hour, &minute, &second) != 6) return;
+    static const char *MONTHS = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    const char *found = strstr(MONTHS, monthName);
+    if (!found || strlen(monthName) != 3 || (found - MONTHS) % 3 != 0) return;
+
+    time_t server = daysFromCivil(year, (found - MONTHS) / 3 + 1, day) * 86400 + hour * 3600 + minute * 60 + second;
+    time_t now = time(nullptr);
+    if (server < CLOCK_VALID_AFTER || (valid() && llabs((int64_t)(server - now)) <= CLOCK_HTTP_MAX_ERROR_S)) return;
+
+    // Whole seconds only, SNTP refines it. Not a drift baseline either.
+    Serial.printf("Clock set from HTTP Date (was off by %llds)\n", (long long)(server - now));
+    step((int64_t)(server - now) * 1000000);
+    rtcLastSync = 0;
+    rtcCorrectedAt = server;
+}
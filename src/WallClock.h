@@ -0,0 +1,46 @@
+#ifndef WALL_CLOCK_H
+#define WALL_CLOCK_H
+
+#include <Arduino.h>
+#include <sys/time.h>
+
+const time_t CLOCK_VALID_AFTER = 1700000000;          // Anything earlier was never set
+const time_t CLOCK_SYNC_INTERVAL_S = 6 * 60 * 60;     // SNTP this often, the RTC runs in between
+const time_t CLOCK_DRIFT_MIN_S = 60 * 60;             // Shorter intervals are too noisy to measure drift
+const int32_t CLOCK_DRIFT_MAX_PPM = 50000;            // RC slow clock worst case (5 %)
+const int64_t CLOCK_MIN_STEP_US = 100000;             // Drift correction steps below this accumulate
+const time_t CLOCK_HTTP_MAX_ERROR_S = 10;             // Date header only overrides a clock this far off
+
+// Wall clock kept in the RTC across deep sleep. The drift of the RTC slow clock is
+// measured at each SNTP sync and corrected on every wake; SNTP only runs every few
+// hours, in the background while the radio is up for the fetch anyway.
+class WallClock {
+public:
+    void begin();               // Every boot: correct the drift accumulated while asleep
+
+    bool valid() const;         // Set at least once since power-on
+    bool syncDue() const;       // Never synced, or the last SNTP sync is too old
+    bool synced() const { return _synced; } // SNTP answered on this wake
+    time_t lastSync() const;
+
+    void startSync();           // Non-blocking, call once WiFi is up
+    void stopSync();            // Before the radio goes down
+    bool waitSync(uint32_t timeoutMs);  // Only where the sync is the point of going online
+
+    // Bootstrap from an HTTP Date header while SNTP is pending,
+    // e.g. "Tue, 15 Nov 1994 08:12:31 GMT". Ignored if the clock is already close.
+    void fromHttpDate(const String &date);
+
+private:
+    volatile bool _synced = false;
+    bool _measure = false;          // Clock was valid when the sync started
+    struct timeval _startWall;      // Wall time and micros() when the sync started,
+    unsigned long _startMicros = 0; // for our own estimate at the moment SNTP answers
+
+    static void onSync(struct timeval *tv);
+    static void step(int64_t deltaUs);
+};
+
+extern WallClock wallClock;
+
+#endif
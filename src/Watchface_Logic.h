@@ -9,89 +9,165 @@
 #include <Fonts/FreeSansBold18pt7b.h>
 
 // Reference the global display object
-extern WeAct42_Driver display;
+extern DisplayDriver display;
+extern uint32_t frameOnPanel; // RenderClient.h
 
-void drawClockFace(bool isNewMinute)
+// --- GEOMETRY (offsets from the centre, precomputed for a 300 px face) ---
+const int WF_CX = EINK_WIDTH / 2;
+const int WF_CY = EINK_HEIGHT / 2;
+const int WF_SIZE = EINK_WIDTH < EINK_HEIGHT ? EINK_WIDTH : EINK_HEIGHT;
+const int WF_MINUTE_R = 3;
+const int WF_HOUR_R = 4;
+
+// Table offset scaled to the panel's short side (identity on the 4.2" panel)
+constexpr int wfScale(int v) { return v * WF_SIZE / 300; }
+
+// Minute ring, radius 100, 12 o'clock first
+static constexpr int8_t WF_MINUTE_DOTS[60][2] = {
+    {0, -100}, {10, -99}, {21, -98}, {31, -95}, {41, -91}, {50, -87},
+    {59, -81}, {67, -74}, {74, -67}, {81, -59}, {87, -50}, {91, -41},
+    {95, -31}, {98, -21}, {99, -10}, {100, 0}, {99, 10}, {98, 21},
+    {95, 31}, {91, 41}, {87, 50}, {81, 59}, {74, 67}, {67, 74},
+    {59, 81}, {50, 87}, {41, 91}, {31, 95}, {21, 98}, {10, 99},
+    {0, 100}, {-10, 99}, {-21, 98}, {-31, 95}, {-41, 91}, {-50, 87},
+    {-59, 81}, {-67, 74}, {-74, 67}, {-81, 59}, {-87, 50}, {-91, 41},
+    {-95, 31}, {-98, 21}, {-99, 10}, {-100, 0}, {-99, -10}, {-98, -21},
+    {-95, -31}, {-91, -41}, {-87, -50}, {-81, -59}, {-74, -67}, {-67, -74},
+    {-59, -81}, {-50, -87}, {-41, -91}, {-31, -95}, {-21, -98}, {-10, -99},
+};
+
+// Hour dots, radius 75
+static constexpr int8_t WF_HOUR_DOTS[12][2] = {
+    {0, -75}, {38, -65}, {65, -38}, {75, 0}, {65, 38}, {38, 65},
+    {0, 75}, {-38, 65}, {-65, 38}, {-75, 0}, {-65, -38}, {-38, -65},
+};
+
+// Red ticks from radius 110 to 120 (x1, y1, x2, y2)
+static constexpr int8_t WF_TICKS[12][4] = {
+    {0, -110, 0, -120}, {55, -95, 60, -104}, {95, -55, 104, -60},
+    {110, 0, 120, 0}, {95, 55, 104, 60}, {55, 95, 60, 104},
+    {0, 110, 0, 120}, {-55, 95, -60, 104}, {-95, 55, -104, 60},
+    {-110, 0, -120, 0}, {-95, -55, -104, -60}, {-55, -95, -60, -104},
+};
+
+// Last rendered time, survives deep sleep
+RTC_DATA_ATTR int8_t wfLastHour = -1;
+RTC_DATA_ATTR int8_t wfLastMinute = -1;
+
+void drawClockFace(const struct tm &t)
 {
-    struct tm t;
-    if (!getLocalTime(&t))
-        return;
+    display.clearBuffer();
+
+    int cx = WF_CX;
+    int cy = WF_CY;
 
-    // Only clear background on new minute to prepare for clean refresh
-    if (isNewMinute)
+    // Red Ticks
+    for (int i = 0; i < 12; i++)
     {
-        display.clearBuffer();
+        const int8_t *k = WF_TICKS[i];
+        int x1 = cx + wfScale(k[0]), y1 = cy + wfScale(k[1]);
+        int x2 = cx + wfScale(k[2]), y2 = cy + wfScale(k[3]);
+        display.drawLine(x1, y1, x2, y2, EINK_RED);
+        display.drawLine(x1 + 1, y1 + 1, x2 + 1, y2 + 1, EINK_RED);
     }
 
-    int cx = 200;
-    int cy = 150;
+    // Inner Hour Dots
+    for (int i = 0; i < 12; i++)
+    {
+        int x = cx + wfScale(WF_HOUR_DOTS[i][0]);
+        int y = cy + wfScale(WF_HOUR_DOTS[i][1]);
+        if (i < t.tm_hour % 12)
+            display.fillCircle(x, y, WF_HOUR_R, EINK_BLACK);
+        else
+            display.drawCircle(x, y, WF_HOUR_R, EINK_BLACK);
+    }
 
-    // --- STATIC ELEMENTS (Draw only if new minute) ---
-    if (isNewMinute)
+    // Minute Ring (Outlines + Filled)
+    for (int m = 0; m < 60; m++)
     {
-        // Red Ticks
-        int r_ticks = 120;
-        for (int i = 0; i < 12; i++)
-        {
-            float a = (i * 30 * 3.14159 / 180.0) - (3.14159 / 2);
-            int x1 = cx + (r_ticks - 10) * cos(a);
-            int y1 = cy + (r_ticks - 10) * sin(a);
-            int x2 = cx + r_ticks * cos(a);
-            int y2 = cy + r_ticks * sin(a);
-            display.drawLine(x1, y1, x2, y2, EINK_RED);
-            display.drawLine(x1 + 1, y1 + 1, x2 + 1, y2 + 1, EINK_RED);
-        }
-
-        // Inner Hour Dots
-        int r_hours = 75;
-
-        for (int i = 0; i < 12; i++)
-        {
-            float a = (i * 30 * 3.14159 / 180.0) - (3.14159 / 2);
-            display.drawCircle(cx + r_hours * cos(a), cy + r_hours * sin(a), 4, EINK_BLACK);
-        }
-        for (int i = 0; i < t.tm_hour % 12; i++)
-        {
-            float a = (i * 30 * 3.14159 / 180.0) - (3.14159 / 2);
-            display.fillCircle(cx + r_hours * cos(a), cy + r_hours * sin(a), 4, EINK_BLACK);
-        }
-
-        // Minute Ring (Outlines + Filled)
-        int r_minutes = 100;
-        for (int m = 0; m < 60; m++)
-        {
-            float a = ((m / 60.0) * 2 * 3.14159) - (3.14159 / 2);
-            display.drawCircle(cx + r_minutes * cos(a), cy + r_minutes * sin(a), 3, EINK_BLACK);
-        }
-        for (int m = 0; m <= t.tm_min; m++)
-        {
-            float a = ((m / 60.0) * 2 * 3.14159) - (3.14159 / 2);
-            display.fillCircle(cx + r_minutes * cos(a), cy + r_minutes * sin(a), 3, EINK_BLACK);
-        }
-
-        // Digital Time
-        display.setTextColor(EINK_BLACK);
-        display.setFont(&FreeSansBold18pt7b);
-        char timeStr[6];
-        sprintf(timeStr, "%02d:%02d", t.tm_hour, t.tm_min);
-        int16_t x, y;
-        uint16_t w, h;
-        display.getTextBounds(timeStr, 0, 0, &x, &y, &w, &h);
-        display.fillRect(cx - w / 2 - 10, cy - h / 2 - 10, w + 20, h + 20, EINK_WHITE);
-        display.setCursor(cx - w / 2 - x, cy - h / 2 - y);
-        display.print(timeStr);
-
-        // Empty Bar Container
-        display.drawRect(0, 290, 400, 10, EINK_BLACK);
+        int x = cx + wfScale(WF_MINUTE_DOTS[m][0]);
+        int y = cy + wfScale(WF_MINUTE_DOTS[m][1]);
+        if (m <= t.tm_min)
+            display.fillCircle(x, y, WF_MINUTE_R, EINK_BLACK);
+        else
+            display.drawCircle(x, y, WF_MINUTE_R, EINK_BLACK);
     }
 
-    // --- DYNAMIC ELEMENT (The 5s Bar) ---
-    // Drawn on top of existing buffer every 5 seconds
-    int barWidth = (t.tm_sec / 5) * (400 / 12);
-    if (barWidth > 0)
+    // Digital Time
+    display.setTextColor(EINK_BLACK);
+    display.setFont(&FreeSansBold18pt7b);
+    char timeStr[6];
+    sprintf(timeStr, "%02d:%02d", t.tm_hour, t.tm_min);
+    int16_t x, y;
+    uint16_t w, h;
+    display.getTextBounds(timeStr, 0, 0, &x, &y, &w, &h);
+    display.setCursor(cx - w / 2 - x, cy - h / 2 - y);
+    display.print(timeStr);
+}
+
+// Box around a dot, with a pixel of margin
+EInkRect watchfaceDotRect(const int8_t *dot, int r)
+{
+    return {(int16_t)(WF_CX + wfScale(dot[0]) - r - 1), (int16_t)(WF_CY + wfScale(dot[1]) - r - 1), (int16_t)(2 * r + 3), (int16_t)(2 * r + 3)};
+}
+
+// Area of the digital time, wide enough for any "HH:MM"
+EInkRect watchfaceTimeRect()
+{
+    display.setFont(&FreeSansBold18pt7b);
+    int16_t x, y;
+    uint16_t w, h;
+    display.getTextBounds("00:00", 0, 0, &x, &y, &w, &h);
+    return {(int16_t)(WF_CX - w / 2 - 10), (int16_t)(WF_CY - h / 2 - 10), (int16_t)(w + 20), (int16_t)(h + 20)};
+}
+
+// Redraw for the current minute with as little panel work as possible:
+// - within the hour only the new minute dots and the digital time are pushed
+// - on the hour the ring (incl. hour dots and time) is pushed as one window
+// - every WF_FULL_EVERY_HOURS, on the first draw or after a gap: full refresh
+const int WF_FULL_EVERY_HOURS = 6;
+
+bool updateWatchface(bool forceFull)
+{
+    struct tm t;
+    if (!getLocalTime(&t, 0))
+        return false;
+
+    drawClockFace(t);
+
+    int gap = t.tm_min - wfLastMinute;
+    bool sameHour = t.tm_hour == wfLastHour && gap >= 1 && gap <= 5;
+    bool nextHour = t.tm_hour == (wfLastHour + 1) % 24 && t.tm_min <= 5 && t.tm_hour % WF_FULL_EVERY_HOURS != 0;
+
+    EInkRect rects[6];
+    int count = 0;
+    if (!forceFull && sameHour)
     {
-        display.fillRect(0, 290, barWidth, 10, EINK_BLACK);
+        rects[count++] = watchfaceTimeRect();
+        for (int m = wfLastMinute + 1; m <= t.tm_min; m++)
+            rects[count++] = watchfaceDotRect(WF_MINUTE_DOTS[m], WF_MINUTE_R);
     }
+    else if (!forceFull && nextHour)
+    {
+        int r = wfScale(100) + WF_MINUTE_R + 2;
+        rects[count++] = {(int16_t)(WF_CX - r), (int16_t)(WF_CY - r), (int16_t)(2 * r + 1), (int16_t)(2 * r + 1)};
+    }
+
+    bool ok = count > 0 ? display.displayPartial(rects, count) : display.display();
+    frameOnPanel = 0;
+
+    wfLastHour = t.tm_hour;
+    wfLastMinute = t.tm_min;
+    return ok;
+}
+
+// Time until just after the next minute boundary
+uint64_t watchfaceSleepMs()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    uint64_t msIntoMinute = (tv.tv_sec % 60) * 1000ULL + tv.tv_usec / 1000;
+    return 60000ULL - msIntoMinute + 200;
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -4,31 +4,71 @@
 #include <Arduino.h>
 #include <SPI.h>
 #include <Adafruit_GFX.h>
+#include "EInkPanel.h"
 
-#define EINK_WIDTH 400
-#define EINK_HEIGHT 300
+// Panel the firmware is built for. The driver speaks the SSD168x command set and the
+// board layout (SBB_Logic.h) is made for 400x300; another module needs both checked first.
+typedef EInkPanel420 PanelGeometry;
 
-// Standard Colors
-#define EINK_BLACK 0x0000
-#define EINK_WHITE 0xFFFF
-#define EINK_RED 0xF800
+const int EINK_WIDTH = PanelGeometry::width;
+const int EINK_HEIGHT = PanelGeometry::height;
 
-class WeAct42_Driver : public Adafruit_GFX
+// What the panel currently shows, kept by the caller across deep sleep.
+// Decides whether a frame without red may use the fast B/W refresh.
+struct EInkPanelState
+{
+    bool redShown;         // Red pixels on the panel (or unknown after power-on)
+    uint8_t fastRefreshes; // Fast refreshes since the last full waveform
+};
+
+// A full tri-colour refresh every few fast ones clears the B/W ghosting
+const uint8_t EINK_FAST_BETWEEN_FULL = 10;
+
+// Windows a single partial update can carry
+const int EINK_MAX_RECTS = 8;
+
+// Longest refresh before BUSY counts as stuck
+const uint32_t EINK_REFRESH_TIMEOUT_MS = 15000;
+
+template <class Panel>
+class EInkDriver : public Adafruit_GFX
 {
 public:
     uint8_t *blackBuffer;
-    uint8_t *redBuffer;
+    uint8_t *redBuffer; // nullptr on black/white panels
+    bool redInk = false; // Red plane holds ink, tracked while drawing
+    EInkPanelState *panel = nullptr;
     int8_t _cs, _dc, _rst, _busy, _clk, _din;
 
-    WeAct42_Driver(int8_t cs, int8_t dc, int8_t rst, int8_t busy, int8_t clk, int8_t din)
-        : Adafruit_GFX(EINK_WIDTH, EINK_HEIGHT), _cs(cs), _dc(dc), _rst(rst), _busy(busy), _clk(clk), _din(din)
+    // Controller state within one wake: after a refresh the controller stays
+    // awake and configured, only powerDown() puts it into deep sleep again.
+    // Leaving deep sleep needs the hardware reset, so that is done lazily.
+    bool _awake = false;
+    EInkRect _window = {0, 0, 0, 0}; // RAM window registers 0x44 / 0x45
+    int16_t _border = -1;            // Border waveform 0x3C, -1 = unknown
+    int16_t _redRam = -1;            // Red RAM option of 0x21, -1 = unknown
+
+    // Refresh in flight: BUSY falling edge notifies the task that started it.
+    // The windows are copied into RAM 0x26 once it is done.
+    volatile bool _refreshing = false;
+    TaskHandle_t _waiter = nullptr;
+    const char *_refreshLabel = "";
+    unsigned long _refreshStart = 0;
+    volatile unsigned long _refreshEnd = 0; // millis() of the BUSY edge, 0 = not yet
+    bool _refreshOk = true;
+    EInkRect _afterRects[EINK_MAX_RECTS];
+    int _afterCount = 0;
+
+    EInkDriver(int8_t cs, int8_t dc, int8_t rst, int8_t busy, int8_t clk, int8_t din)
+        : Adafruit_GFX(Panel::width, Panel::height), _cs(cs), _dc(dc), _rst(rst), _busy(busy), _clk(clk), _din(din)
     {
-        blackBuffer = (uint8_t *)malloc(EINK_WIDTH * EINK_HEIGHT / 8);
-        redBuffer = (uint8_t *)malloc(EINK_WIDTH * EINK_HEIGHT / 8);
+        blackBuffer = (uint8_t *)malloc(Panel::planeBytes);
+        redBuffer = Panel::planes > 1 ? (uint8_t *)malloc(Panel::planeBytes) : nullptr;
     }
 
-    void begin()
+    void begin(EInkPanelState *state = nullptr)
     {
+        panel = state;
         pinMode(_cs, OUTPUT);
         pinMode(_dc, OUTPUT);
         pinMode(_rst, OUTPUT);
@@ -55,7 +95,8 @@ public:
         digitalWrite(_cs, HIGH);
     }
 
-    void waitBusy(const char* label = "unknown")
+    // Returns false if the panel did not release BUSY in time
+    bool waitBusy(const char* label = "unknown")
     {
         delay(50); // Small initial delay to allow busy pin to transition
         unsigned long start = millis();
@@ -63,16 +104,18 @@ public:
         while (digitalRead(_busy) == HIGH)
         {
             wasBusy = true;
-            if (millis() - start > 15000) // 15s timeout
+            if (millis() - start > EINK_REFRESH_TIMEOUT_MS)
             {
                 Serial.printf("WaitBusy [%s] TIMEOUT!\n", label);
-                break;
+                _awake = false; // Start over with a reset next time
+                return false;
             }
             delay(10);
         }
         if (wasBusy) {
             Serial.printf("WaitBusy [%s] done in %ums\n", label, (unsigned int)(millis() - start));
         }
+        return true;
     }
 
     void hardwareInit()
@@ -85,10 +128,17 @@ public:
         writeCMD(0x12);
         waitBusy("sw_reset");
 
+        // Gate lines = panel height
+        writeCMD(0x01);
+        writeDATA((Panel::height - 1) & 0xFF);
+        writeDATA((Panel::height - 1) >> 8);
+        writeDATA(0x00);
+
         // CRITICAL FIX: Enable Red RAM (0x00 instead of 0x40)
         writeCMD(0x21);
         writeDATA(0x00);
         writeDATA(0x00);
+        _redRam = 0x00;
 
         writeCMD(0x3C);
         writeDATA(0x05);
@@ -96,75 +146,297 @@ public:
         writeDATA(0x03);
         writeCMD(0x44);
         writeDATA(0x00);
-        writeDATA(0x31);
+        writeDATA(Panel::rowBytes - 1);
         writeCMD(0x45);
         writeDATA(0x00);
         writeDATA(0x00);
-        writeDATA(0x2B);
-        writeDATA(0x01);
+        writeDATA((Panel::height - 1) & 0xFF);
+        writeDATA((Panel::height - 1) >> 8);
         writeCMD(0x4E);
         writeDATA(0x00);
         writeCMD(0x4F);
         writeDATA(0x00);
         writeDATA(0x00);
+
+        _window = {0, 0, Panel::width, Panel::height};
+        _border = 0x05;
     }
 
-    // --- FINAL PIXEL LOGIC ---
-    // Black Buffer: 0 = Ink (Black), 1 = Paper (White)
-    // Red Buffer:   1 = Ink (Red),   0 = Paper (Transparent)
-    void drawPixel(int16_t x, int16_t y, uint16_t color)
+    // Reset and init only if the controller is in deep sleep (or unknown after boot)
+    void wake()
     {
-        if ((x < 0) || (x >= width()) || (y < 0) || (y >= height()))
+        if (_awake)
             return;
-        uint16_t byteIdx = (x + y * EINK_WIDTH) / 8;
-        uint8_t bitMask = 0x80 >> (x % 8);
+        hardwareInit();
+        _awake = true;
+    }
 
-        if (color == EINK_BLACK)
-        {
-            // Black: Set Black to 0, Red to 0
-            blackBuffer[byteIdx] &= ~bitMask;
-            redBuffer[byteIdx] &= ~bitMask;
-        }
-        else if (color == EINK_RED)
+    void setBorder(uint8_t border)
+    {
+        if (_border == border)
+            return;
+        writeCMD(0x3C);
+        writeDATA(border);
+        _border = border;
+    }
+
+    // Display Update Control 1: 0x00 = red RAM normal, 0x40 = bypassed as 0.
+    // Mode 2 needs it normal (RAM 0x26 is the previous image there); only the
+    // full refresh of a black/white panel bypasses it, as GxEPD2 does.
+    void setRedRam(uint8_t option)
+    {
+        if (_redRam == option)
+            return;
+        writeCMD(0x21);
+        writeDATA(option);
+        writeDATA(0x00);
+        _redRam = option;
+    }
+
+    // Pixel layout of the planes: see EInkPanel
+    void drawPixel(int16_t x, int16_t y, uint16_t color)
+    {
+        redInk |= Panel::setPixel(blackBuffer, redBuffer, x, y, color);
+    }
+
+    // Horizontal span straight into the planes: edge bytes masked, the rest memset
+    void fillSpan(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+        redInk |= Panel::fillSpan(blackBuffer, redBuffer, x, y, w, color);
+    }
+
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override
+    {
+        fillSpan(x, y, w, color);
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override
+    {
+        for (int16_t row = y; row < y + h; row++)
+            fillSpan(x, row, w, color);
+    }
+
+    // Masked blit: every sprite byte lands in (at most) two buffer bytes
+    void drawSprite(int16_t x, int16_t y, const EInkSprite &s)
+    {
+        redInk |= Panel::drawSprite(blackBuffer, redBuffer, x, y, s);
+    }
+
+    // For planes filled directly (frame store, render service) instead of drawn
+    void scanRedPlane()
+    {
+        redInk = Panel::hasRed(redBuffer);
+    }
+
+    // Fast B/W refresh when neither the frame nor the panel has red,
+    // otherwise the full tri-colour waveform. Blocks until the panel is done.
+    bool display()
+    {
+        displayAsync();
+        return finishRefresh();
+    }
+
+    // Same as display(), but returns as soon as the refresh runs. Leave the
+    // framebuffers alone until finishRefresh(); the next refresh, clearBuffer()
+    // and powerDown() wait for it themselves.
+    void displayAsync()
+    {
+        if (panel && !redInk && !panel->redShown && panel->fastRefreshes < EINK_FAST_BETWEEN_FULL)
         {
-            // Red: Set Black to 1 (White), Red to 1 (Red)
-            // Note: Black must be "White" (1) for Red to show
-            blackBuffer[byteIdx] |= bitMask;
-            redBuffer[byteIdx] |= bitMask;
+            panel->fastRefreshes++;
+            startFast();
+            return;
         }
-        else
+        if (panel)
         {
-            // White: Set Black to 1, Red to 0
-            blackBuffer[byteIdx] |= bitMask;
-            redBuffer[byteIdx] &= ~bitMask;
+            panel->redShown = redInk;
+            panel->fastRefreshes = 0;
         }
+        startFull();
     }
 
-    void display()
+    void startFull()
     {
-        hardwareInit();
+        finishRefresh();
+        wake();
+        setBorder(0x05);
+        setRedRam(Panel::planes > 1 ? 0x00 : 0x40);
+        setRamWindow({0, 0, Panel::width, Panel::height});
         writeCMD(0x24);
-        for (int i = 0; i < 15000; i++)
+        for (uint32_t i = 0; i < Panel::planeBytes; i++)
             writeDATA(blackBuffer[i]);
+        // Black/white panels ignore RAM 0x26 in display mode 1
+        const uint8_t *second = Panel::planes > 1 ? redBuffer : blackBuffer;
+        writeCMD(0x26);
+        for (uint32_t i = 0; i < Panel::planeBytes; i++)
+            writeDATA(second[i]);
+
+        // Afterwards the B/W image goes to RAM 0x26 as the "previous" frame for
+        // partial updates. RAM is retained in deep sleep mode 1.
+        const EInkRect full = {0, 0, Panel::width, Panel::height};
+        startRefresh(0xF7, "refresh", &full, 1); // Display mode 1 (full waveform)
+    }
+
+    // Full screen B/W update with the short display mode 2 waveform. RAM 0x26
+    // gets the inverted frame first, so every pixel differs from the "previous"
+    // image and is driven (not just the changed ones as in displayPartial).
+    // The red particles are not moved, so this needs a panel without red.
+    void startFast()
+    {
+        finishRefresh();
+        wake();
+        setBorder(0x80); // Keep the border as is
+        setRedRam(0x00);
+        setRamWindow({0, 0, Panel::width, Panel::height});
+
         writeCMD(0x26);
-        for (int i = 0; i < 15000; i++)
-            writeDATA(redBuffer[i]);
+        for (uint32_t i = 0; i < Panel::planeBytes; i++)
+            writeDATA(~blackBuffer[i]);
+        writeCMD(0x24);
+        for (uint32_t i = 0; i < Panel::planeBytes; i++)
+            writeDATA(blackBuffer[i]);
+
+        const EInkRect full = {0, 0, Panel::width, Panel::height};
+        startRefresh(0xFF, "fast", &full, 1); // Display mode 2
+    }
+
+    static void IRAM_ATTR busyIsr(void *arg)
+    {
+        EInkDriver *self = (EInkDriver *)arg;
+        BaseType_t woken = pdFALSE;
+        if (self->_refreshing && self->_refreshEnd == 0)
+            self->_refreshEnd = millis();
+        if (self->_refreshing && self->_waiter)
+            vTaskNotifyGiveFromISR(self->_waiter, &woken);
+        if (woken)
+            portYIELD_FROM_ISR();
+    }
+
+    // Triggers the update sequence, BUSY goes high until the panel is done
+    void startRefresh(uint8_t mode, const char *label, const EInkRect *after, int count)
+    {
+        if (count > EINK_MAX_RECTS)
+            count = EINK_MAX_RECTS;
+        memcpy(_afterRects, after, count * sizeof(EInkRect));
+        _afterCount = count;
+        _refreshLabel = label;
+        _waiter = xTaskGetCurrentTaskHandle();
+        ulTaskNotifyTake(pdTRUE, 0); // Drop a stale notification
+
+        writeCMD(0x22);
+        writeDATA(mode);
+        _refreshEnd = 0;
+        _refreshing = true;
+        attachInterruptArg(digitalPinToInterrupt(_busy), busyIsr, this, FALLING);
+        _refreshStart = millis();
         writeCMD(0x20);
-        waitBusy("refresh");
-        writeCMD(0x10);
-        writeDATA(0x01);
+    }
+
+    bool refreshing() const { return _refreshing; }
+    // When the last refresh ended (BUSY edge), even if it was collected later
+    unsigned long refreshEndMs() const { return _refreshEnd; }
+
+    // Waits for the BUSY interrupt of the running refresh (if any) and stores
+    // the new image as the previous one. False if BUSY did not release in time,
+    // without a refresh running the outcome of the last one.
+    bool finishRefresh()
+    {
+        if (!_refreshing)
+            return _refreshOk;
+        // Must run on the task that started the refresh (it gets the notification)
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(EINK_REFRESH_TIMEOUT_MS));
+        detachInterrupt(digitalPinToInterrupt(_busy));
+        _refreshing = false;
+        if (_refreshEnd == 0)
+            _refreshEnd = millis();
+
+        // Level check as well, the edge can be missed on a very short refresh
+        _refreshOk = digitalRead(_busy) == LOW;
+        if (!_refreshOk)
+        {
+            Serial.printf("Refresh [%s] TIMEOUT!\n", _refreshLabel);
+            _awake = false; // Start over with a reset next time
+            return false;
+        }
+        Serial.printf("Refresh [%s] done in %ums\n", _refreshLabel, (unsigned int)(_refreshEnd - _refreshStart));
+
+        for (int i = 0; i < _afterCount; i++)
+            writeWindow(0x26, _afterRects[i]);
+        return true;
+    }
+
+    // Restrict RAM access to a window, x is rounded out to whole bytes.
+    // The window registers are only sent when they change, the address
+    // counter always (it moves with every RAM write).
+    void setRamWindow(const EInkRect &r)
+    {
+        uint8_t xs = r.x / 8;
+        uint8_t xe = (r.x + r.w - 1) / 8;
+        int16_t ye = r.y + r.h - 1;
+        if (r.x != _window.x || r.y != _window.y || r.w != _window.w || r.h != _window.h)
+        {
+            writeCMD(0x44);
+            writeDATA(xs);
+            writeDATA(xe);
+            writeCMD(0x45);
+            writeDATA(r.y & 0xFF);
+            writeDATA(r.y >> 8);
+            writeDATA(ye & 0xFF);
+            writeDATA(ye >> 8);
+            _window = r;
+        }
+        writeCMD(0x4E);
+        writeDATA(xs);
+        writeCMD(0x4F);
+        writeDATA(r.y & 0xFF);
+        writeDATA(r.y >> 8);
+    }
+
+    void writeWindow(uint8_t ramCmd, const EInkRect &r)
+    {
+        setRamWindow(r);
+        writeCMD(ramCmd);
+        for (int16_t row = r.y; row < r.y + r.h; row++)
+            for (int16_t col = r.x / 8; col <= (r.x + r.w - 1) / 8; col++)
+                writeDATA(blackBuffer[Panel::byteIndex(col * 8, row)]);
+    }
+
+    // B/W partial update (display mode 2): only the given windows are sent,
+    // the controller drives just the pixels that differ from RAM 0x26.
+    // Red content already on the panel is left untouched.
+    bool displayPartial(const EInkRect *rects, int count)
+    {
+        finishRefresh();
+        wake();
+        setBorder(0x80); // Keep the border as is
+        setRedRam(0x00);
+
+        for (int i = 0; i < count; i++)
+            writeWindow(0x24, rects[i]);
+
+        // New image becomes the previous one for the next partial update
+        startRefresh(0xFF, "partial", rects, count); // Display mode 2
+        return finishRefresh();
     }
 
     // Clear to White: Black=1, Red=0
     void clearBuffer()
     {
-        memset(blackBuffer, 0xFF, 15000);
-        memset(redBuffer, 0x00, 15000);
+        finishRefresh();
+        Panel::clear(blackBuffer, redBuffer);
+        redInk = false;
     }
+    // Deep sleep mode 1 (RAM retained), the next refresh resets the controller
     void powerDown()
     {
+        finishRefresh();
+        if (!_awake)
+            return;
         writeCMD(0x10);
         writeDATA(0x01);
+        _awake = false;
     }
 };
+
+typedef EInkDriver<PanelGeometry> DisplayDriver;
 #endif
\ No newline at end of file
@@ -4,9 +4,14 @@
 #include <Arduino.h>
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
+#include "HttpJson.h"
+#include "RequestBudget.h"
+#include "DnsCache.h"
+#include "Telemetry.h"
 #include "WeAct_EInk.h"
+#include "WeatherIcons.h"
 
-extern WeAct42_Driver display;
+extern DisplayDriver display;
 
 struct WeatherData
 {
@@ -15,78 +20,12 @@ struct WeatherData
     bool valid;
 };
 
+// Pre-rendered icon for the WMO code, centered on (x, y)
 inline void drawWeatherSymbol(int x, int y, int code)
 {
-    // Basic symbols drawn using primitives
-    if (code == 0)
-    {                                          // Clear sky
-        display.fillCircle(x, y, 8, EINK_RED); // Red sun
-        for (int i = 0; i < 8; i++)
-        {
-            float a = i * 45 * PI / 180.0;
-            display.drawLine(x + 10 * cos(a), y + 10 * sin(a), x + 14 * cos(a), y + 14 * sin(a), EINK_RED);
-        }
-    }
-    else if (code <= 3)
-    {                                                  // Partly cloudy
-        display.fillCircle(x - 8, y - 3, 8, EINK_RED); // Red sun
-        display.drawCircle(x - 4, y + 2, 6, EINK_BLACK);
-        display.drawCircle(x + 4, y + 2, 6, EINK_BLACK);
-        display.drawCircle(x, y - 2, 6, EINK_BLACK);
-        display.fillCircle(x - 4, y + 2, 4, EINK_WHITE);
-        display.fillCircle(x, y - 2, 4, EINK_WHITE);
-        display.fillCircle(x + 4, y + 2, 4, EINK_WHITE);
-    }
-    else if (code >= 51 && code <= 67 || code >= 80 && code <= 82)
-    { // Rain
-        display.fillCircle(x - 4, y + 2, 6, EINK_BLACK);
-        display.fillCircle(x + 4, y + 2, 6, EINK_BLACK);
-        display.fillCircle(x, y - 2, 6, EINK_BLACK);
-        display.drawLine(x - 4, y + 6, x - 8, y + 14, EINK_RED);
-        display.drawLine(x, y + 6, x - 4, y + 14, EINK_RED);
-        display.drawLine(x + 4, y + 6, x + 0, y + 14, EINK_RED);
-    }
-    else if (code >= 71 && code <= 77 || code >= 85 && code <= 86)
-    { // Snow
-        display.drawCircle(x - 4, y + 2, 6, EINK_BLACK);
-        display.drawCircle(x + 4, y + 2, 6, EINK_BLACK);
-        display.drawCircle(x, y - 2, 6, EINK_BLACK);
-        display.fillCircle(x - 4, y + 2, 4, EINK_WHITE);
-        display.fillCircle(x, y - 2, 4, EINK_WHITE);
-        display.fillCircle(x + 4, y + 2, 4, EINK_WHITE);
-        int x_off = -5;
-        int y_off = 8;
-        for (int i = 0; i < 6; i++)
-        {
-            float a = (i * 60) * PI / 180.0;
-            int x1 = x + x_off + (int)(12 * cos(a));
-            int y1 = y + y_off + (int)(12 * sin(a));
-            display.drawLine(x + x_off, y + y_off, x1, y1, EINK_RED);
-
-            // Side branches
-            int bx = x + x_off + (int)(8 * cos(a));
-            int by = y + y_off + (int)(8 * sin(a));
-
-            float ba1 = a + PI / 3;
-            float ba2 = a - PI / 3;
-
-            display.drawLine(bx, by, bx + (int)(5 * cos(ba1)), by + (int)(5 * sin(ba1)), EINK_RED);
-            display.drawLine(bx, by, bx + (int)(5 * cos(ba2)), by + (int)(5 * sin(ba2)), EINK_RED);
-        }
-    }
-    else if (code == 45 || code == 48)
-    {                                                  // Fog
-        display.drawCircle(x - 8, y - 3, 8, EINK_RED); // Red sun
-        display.fillRect(x - 8, y - 2, 20, 2, EINK_BLACK);
-        display.fillRect(x - 12, y + 4, 20, 2, EINK_BLACK);
-        display.fillRect(x - 10, y + 10, 20, 2, EINK_BLACK);
-    }
-    else
-    { // Generic cloud for everything else
-        display.fillCircle(x - 5, y + 3, 5, EINK_BLACK);
-        display.fillCircle(x + 5, y + 3, 5, EINK_BLACK);
-        display.fillCircle(x, y - 1, 7, EINK_BLACK);
-    }
+    uint8_t index = (code >= 0 && code < 100) ? WEATHER_ICON_BY_CODE[code] : WEATHER_ICON_FALLBACK;
+    const EInkSprite &icon = WEATHER_ICONS[index];
+    display.drawSprite(x - icon.w / 2, y - icon.h / 2, icon);
 }
 
 inline WeatherData fetchWeather(double lat, double lon)
@@ -95,6 +34,7 @@ inline WeatherData fetchWeather(double lat, double lon)
     if (WiFi.status() != WL_CONNECTED)
         return data;
 
+    WiFiClient client;
     HTTPClient http;
     // Using Open-Meteo as a proxy for Swiss coordinates
     String url = "http://api.open-meteo.com/v1/forecast?latitude=" + String(lat, 4) +
@@ -105,14 +45,17 @@ inline WeatherData fetchWeather(double lat, double lon)
     Serial.print(", ");
     Serial.println(lon, 4);
 
-    if (http.begin(url))
+    dnsCache.connect(client, url); // Times DNS and connect itself
+    if (http.begin(client, url))
     {
+        telemetry.phaseStart(PHASE_FETCH);
+        requestCompressed(http);
         int httpCode = http.GET();
+        budget.record(API_WEATHER, httpCode, http.header("Retry-After"));
         if (httpCode == HTTP_CODE_OK)
         {
-            String payload = http.getString();
             JsonDocument doc;
-            if (!deserializeJson(doc, payload))
+            if (!deserializeResponse(http, doc, "Weather"))
             {
                 data.temp = doc["current_weather"]["temperature"];
                 data.code = doc["current_weather"]["weathercode"];
@@ -129,6 +72,7 @@ inline WeatherData fetchWeather(double lat, double lon)
             Serial.println(httpCode);
         }
         http.end();
+        telemetry.phaseEnd(PHASE_FETCH);
     }
     return data;
 }
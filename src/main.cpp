@@ -10,19 +10,28 @@
 #include "SBB_Logic.h"
 #include "Config_GUI.h"
 #include "BleHandler.h"
+#include "Telemetry.h"
+#include "Watchface_Logic.h"
+#include "ButtonInput.h"
+#include "UlpSupervisor.h"
+#include "PowerManager.h"
+#include "RenderClient.h"
+#include "FrameStore.h"
+#include "RetryPolicy.h"
+#include "RequestBudget.h"
+#include "WallClock.h"
 
 BleHandler ble;
 bool configMode = false;
 
 // --- DRIVER ---
-WeAct42_Driver display(PIN_EINK_CS, PIN_EINK_DC, PIN_EINK_RST, PIN_EINK_BUSY, PIN_EINK_CLK, PIN_EINK_DIN);
+DisplayDriver display(PIN_EINK_CS, PIN_EINK_DC, PIN_EINK_RST, PIN_EINK_BUSY, PIN_EINK_CLK, PIN_EINK_DIN);
 
 // --- GLOBALS ---
 unsigned long lastUpdate = 0;
-volatile unsigned long pressStartTime = 0;
-volatile bool shouldUpdate = false;
-volatile bool shouldConfig = false;
-volatile bool shouldShowQR = false;
+bool shouldUpdate = false;
+bool shouldConfig = false;
+bool shouldShowQR = false;
 
 // Pages
 enum Page
@@ -34,33 +43,225 @@ Page currentPage = PAGE_SBB;
 unsigned long qrStartTime = 0;
 const unsigned long QR_TIMEOUT_MS = 5 * 60 * 1000; // 5 minutes
 
-void IRAM_ATTR onButton()
+// Lets frames without red use the fast refresh across wakes (unknown after power-on)
+RTC_DATA_ATTR EInkPanelState panelState = {true, 0};
+
+// Set once the ULP reported a low battery, so it does not wake us every minute
+RTC_DATA_ATTR bool batteryLowReported = false;
+
+bool watchfaceMode()
+{
+    return DISPLAY_MODE == MODE_WATCHFACE;
+}
+
+// Watchface keeps time in the RTC and only goes online to resync it
+bool clockNeedsSync()
+{
+    return !wallClock.valid() || wallClock.syncDue();
+}
+
+// --- RADIO ---
+bool pollButton(TickType_t wait);
+
+// WiFi and BT off (esp_wifi_stop), nothing after the fetch needs them
+void radioDown()
+{
+    wallClock.stopSync();
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);
+    if (btStarted())
+        btStop();
+    telemetry.radioEnd();
+}
+
+// Connect with a bounded timeout, a failure is recorded for the backoff.
+// Gestures are still handled while waiting (a very long press aborts).
+bool radioUp()
 {
-    int state = digitalRead(PIN_TOUCH);
-    if (state == HIGH) // Pressed (Active HIGH as per original code)
+    if (WiFi.status() == WL_CONNECTED)
+        return true;
+
+    Serial.print("Connecting to ");
+    Serial.println(WIFI_SSID);
+    telemetry.phaseStart(PHASE_WIFI);
+    telemetry.radioStart();
+    retry.attemptStart();
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(WIFI_SSID.c_str(), WIFI_PASS.c_str());
+
+    unsigned long start = millis();
+    while (WiFi.status() != WL_CONNECTED && millis() - start < WIFI_CONNECT_TIMEOUT_MS && !shouldConfig)
     {
-        pressStartTime = millis();
+        pollButton(pdMS_TO_TICKS(500));
+        Serial.print(".");
     }
-    else // Released (LOW)
+    telemetry.phaseEnd(PHASE_WIFI);
+
+    if (WiFi.status() == WL_CONNECTED)
     {
-        if (pressStartTime > 0)
-        {
-            unsigned long duration = millis() - pressStartTime;
-            if (duration > 8000)
-            {
-                shouldConfig = true;
-            }
-            else if (duration > 3000)
-            {
-                shouldShowQR = true;
-            }
-            else if (duration > 50)
-            { // Debounce 50ms
-                shouldUpdate = true;
-            }
-            pressStartTime = 0; // Reset
-        }
+        Serial.println("\nWiFi Connected!");
+        if (clockNeedsSync())
+            wallClock.startSync(); // Lands in the background while we fetch
+        return true;
+    }
+
+    if (!shouldConfig)
+    {
+        // Keep waiting out the timeout on a rejection, handshakes can fail transiently
+        bool auth = retry.authRejected();
+        Serial.println(auth ? "\nWiFi rejected the credentials" : "\nWiFi Timeout");
+        telemetry.setError(auth ? ERR_WIFI_AUTH : ERR_WIFI_TIMEOUT);
+        retry.failure(auth ? FAIL_AUTH : FAIL_NETWORK);
+    }
+    radioDown();
+    return false;
+}
+
+// Nothing new could be fetched
+void showOffline()
+{
+    if (watchfaceMode())
+        updateWatchface(false); // The RTC keeps running, only the sync is missing
+    else
+        showStaleBoard();
+    frameOnPanel = 0; // The next thin client fetch has to be a full one
+}
+
+// Redraw whatever the current mode shows.
+// All network work happens first, the radio is off while drawing and during the panel refresh.
+void refreshContent(bool forceFull)
+{
+    if (watchfaceMode())
+    {
+        updateWatchface(forceFull);
+        return;
+    }
+
+    // Rate limited or out of quota: no point in going online, the budget picks the next wake
+    if (RENDER_URL.length() == 0 && UPSTREAM_URL.length() == 0 && !budget.allow(API_SBB))
+    {
+        telemetry.setError(ERR_RATE_LIMITED);
+        showOffline();
+        return;
+    }
+
+    if (!radioUp())
+    {
+        if (!shouldConfig)
+            showOffline();
+        return;
+    }
+
+    // Thin client first, local rendering if it is off or the service is down
+    FrameResult frame = RENDER_URL.length() > 0 ? fetchFrame(forceFull) : FRAME_FAILED;
+    Board board;
+    bool haveBoard = frame == FRAME_FAILED && fetchBoard(board);
+    radioDown();
+
+    if (frame == FRAME_FAILED && !haveBoard)
+    {
+        // Online but no data: keep the last board, marked stale
+        retry.failure(FAIL_SERVER);
+        showOffline();
+        return;
+    }
+
+    retry.success();
+    staleOnPanel = false;
+    if (frame == FRAME_LOADED)
+    {
+        pushFrame();
+    }
+    else if (haveBoard)
+    {
+        if (board.fetchedAt == 0) // The board cache sends its own fetch time
+            board.fetchedAt = time(nullptr);
+        cachedBoard = board;
+        showBoard(board);
+    }
+}
+
+// Button refreshes draw from a token bucket so presses cannot eat the daily API quota.
+// Throttled, the board on the panel is redrawn (clears the badge) without going online.
+bool manualRefreshAllowed()
+{
+    if (watchfaceMode() || budget.takeManual())
+        return true;
+    Serial.println("Manual refresh throttled (request budget)");
+    if (cachedBoard.fetchedAt != 0)
+        showBoard(cachedBoard, staleOnPanel);
+    return false;
+}
+
+// --- STATIC SCREENS ---
+// Config and QR screens only depend on the settings, so they are baked into
+// the frame store on save and just decompressed when shown
+void bakeStaticScreens()
+{
+    uint32_t key = settingsCrc();
+    drawConfigScreen();
+    frameStore.store(FRAME_SLOT_CONFIG, key, display.blackBuffer, display.redBuffer);
+    if (WLAN_QR_ENABLED)
+    {
+        drawQRCodePage();
+        frameStore.store(FRAME_SLOT_QR, key, display.blackBuffer, display.redBuffer);
+    }
+}
+
+// Falls back to drawing (and baking) if the stored screen is missing or stale.
+// Returns while the panel refreshes, e.g. BLE comes up in the meantime.
+void showStaticScreen(FrameSlot slot, void (*draw)())
+{
+    uint32_t key = settingsCrc();
+    finishPanelRefresh(); // The planes are about to be overwritten
+    if (frameStore.load(slot, key, display.blackBuffer, display.redBuffer))
+    {
+        display.scanRedPlane();
+    }
+    else
+    {
+        draw();
+        frameStore.store(slot, key, display.blackBuffer, display.redBuffer);
     }
+    display.displayAsync();
+    frameOnPanel = 0; // Survives the reboot after config mode
+}
+
+// Turns a decoded gesture into the flags handled by setup() / loop()
+void handleButton(ButtonEvent event)
+{
+    switch (event)
+    {
+    case BUTTON_PRESS:
+        // Instant feedback, the actual update follows on release
+        if (configMode)
+            ble.advertiseFast(); // Make it easy to find again
+        else if (currentPage == PAGE_SBB && !watchfaceMode())
+            drawUpdatingBadge();
+        break;
+    case BUTTON_SHORT:
+        shouldUpdate = true;
+        break;
+    case BUTTON_LONG:
+        shouldShowQR = true;
+        break;
+    case BUTTON_VERY_LONG:
+        shouldConfig = true;
+        break;
+    }
+}
+
+// Handle all pending gestures, waiting up to `wait` for the first one
+bool pollButton(TickType_t wait = 0)
+{
+    ButtonEvent event;
+    bool any = false;
+    while (button.next(event, any ? 0 : wait))
+    {
+        handleButton(event);
+        any = true;
+    }
+    return any;
 }
 
 void enterConfigMode()
@@ -70,13 +271,11 @@ void enterConfigMode()
     statusLed.setState(LED_CONFIG); // Orange Breathing
 
     // Stop WiFi
-    WiFi.disconnect(true);
-    WiFi.mode(WIFI_OFF);
+    radioDown();
     delay(100);
 
     // Initial Draw
-    drawConfigScreen();
-    display.display();
+    showStaticScreen(FRAME_SLOT_CONFIG, drawConfigScreen);
 
     // Start BLE
     ble.begin();
@@ -88,116 +287,134 @@ void setup()
     // CPU Frequency scaling (Battery Optimization)
     // 80MHz is plenty for fetching and e-ink updates while saving power
     setCpuFrequencyMhz(80);
+    telemetry.beginCycle();
 
     // Load Settings from NVS
     loadSettings();
 
     // Init Hardware
-    display.begin();
+    display.begin(&panelState);
+    frameStore.begin();
+    ble.onSaved(bakeStaticScreens);
+    retry.begin();
     statusLed.begin(); // Init LED
-    pinMode(PIN_TOUCH, INPUT);
+    ulp.begin();       // Event that woke us (gesture / battery), must run before button.begin()
+    button.begin();    // Picks up a press that woke us
+    power.begin();     // Battery sample, picks the energy tier for this cycle
 
-    // Check wakeup reason
-    esp_sleep_wakeup_cause_t wakeup_reason = esp_sleep_get_wakeup_cause();
-
-    if (wakeup_reason == ESP_SLEEP_WAKEUP_EXT0 || wakeup_reason == ESP_SLEEP_WAKEUP_EXT1 || digitalRead(PIN_TOUCH) == HIGH)
+    if (ulp.wakeEvent() == ULP_EVENT_BATTERY_LOW)
     {
-        // Simple hold detection in setup
-        unsigned long start = millis();
-        while (digitalRead(PIN_TOUCH) == HIGH && (millis() - start < 8500))
-        {
-            delay(10);
-        }
-        unsigned long duration = millis() - start;
+        Serial.println("ULP: Battery low");
+        batteryLowReported = true;
+    }
+    else if (ulp.batteryRaw() > ULP_BATTERY_LOW_RAW + ULP_BATTERY_HYSTERESIS_RAW)
+    {
+        batteryLowReported = false; // Charged again, re-arm the threshold
+    }
 
-        if (duration > 8000)
-        {
-            enterConfigMode();
-        }
-        else if (duration > 3000)
-        {
-            shouldShowQR = true;
-        }
-        else if (duration > 50)
-        {
-            shouldUpdate = true;
-        }
+    // Show the badge right away if the button woke us; the gesture resolves in the background
+    pollButton();
+    if (shouldConfig || WIFI_SSID.length() == 0) // Gesture, or nothing to connect to yet
+    {
+        shouldConfig = false;
+        enterConfigMode();
     }
 
-    attachInterrupt(digitalPinToInterrupt(PIN_TOUCH), onButton, CHANGE);
+    // RTC keeps UTC across deep sleep, the TZ rule has to be set on every boot
+    setenv("TZ", TIMEZONE_STR, 1);
+    tzset();
+    wallClock.begin(); // Drift accumulated while asleep
 
-    // If not in config mode, connect to WiFi
-    if (!configMode)
+    // Watchface: skip WiFi entirely while the RTC time is trusted (or a failed sync is backing off)
+    if (!configMode && watchfaceMode() && (!clockNeedsSync() || !retry.due()))
     {
-        Serial.print("Connecting to ");
-        Serial.println(WIFI_SSID);
-        WiFi.begin(WIFI_SSID.c_str(), WIFI_PASS.c_str());
+        statusLed.setState(LED_OFF);
+        updateWatchface(shouldUpdate); // Short press forces a full refresh
+        shouldUpdate = false;
+        return;
+    }
 
-        // Wait for connection with timeout/escape
-        unsigned long wifiCheckStart = millis();
-        while (WiFi.status() != WL_CONNECTED)
+    // A button wake past the manual refresh budget keeps the board and goes back to sleep
+    if (!configMode && shouldUpdate && !manualRefreshAllowed())
+    {
+        shouldUpdate = false;
+        return;
+    }
+
+    // If not in config mode, connect to WiFi. Offline the last board stays up (marked stale)
+    // and the next attempt backs off; config mode only if the AP keeps rejecting the credentials.
+    if (!configMode && !radioUp() && !shouldConfig)
+    {
+        if (retry.wantsConfig())
+        {
+            Serial.println("Credentials rejected repeatedly -> Entering Config Mode");
+            enterConfigMode();
+        }
+        else
         {
-            delay(500);
-            Serial.print(".");
-
-            // Check for Timeout (30s)
-            if (millis() - wifiCheckStart > 30000)
-            {
-                Serial.println("\nWiFi Timeout (30s) -> Entering Config Mode");
-                enterConfigMode();
-                break;
-            }
-
-            // Allow entering config mode while stuck connecting
-            if (shouldConfig)
-            {
-                enterConfigMode();
-                break;
-            }
-            if (digitalRead(PIN_TOUCH) == HIGH && pressStartTime != 0 && (millis() - pressStartTime > 5000))
-            {
-                enterConfigMode();
-                break;
-            }
+            showOffline();
         }
     }
 
     if (!configMode && WiFi.status() == WL_CONNECTED)
     {
-        Serial.println("\nWiFi Connected!");
         statusLed.setState(LED_OFF); // Battery Opt: LED off after connection
 
-        // --- TIME SYNC (REQUIRED FOR TIMESTAMP) ---
-        configTime(0, 0, "pool.ntp.org");
-        setenv("TZ", TIMEZONE_STR, 1);
-        tzset();
+        if (watchfaceMode())
+        {
+            // Only online for SNTP (started by radioUp), drop the radio before drawing
+            if (wallClock.waitSync(10000))
+                retry.success();
+            radioDown();
+            updateWatchface(true);
+            shouldUpdate = false;
+            return;
+        }
 
-        // First Update
-        fetchSBB();
-        lastUpdate = millis();
+        // First Update (covers a short press that woke us, a long press shows the QR in loop())
+        if (!shouldShowQR)
+        {
+            refreshContent(false);
+            lastUpdate = millis();
+        }
+        shouldUpdate = false;
     }
 }
 
 void goToSleep()
 {
     Serial.println("Preparing for Deep Sleep...");
-    delay(11000); // Increased to 5s to ensure display refresh completes
+    if (!watchfaceMode() && pollButton(pdMS_TO_TICKS(11000)))
+    {
+        return; // Pressed while settling, loop() handles it
+    }
 
     Serial.println("Entering Deep Sleep now.");
     Serial.flush();
 
-    // Shut down hardware
+    // Shut down hardware. The board refresh has run during the button window,
+    // it is collected before endCycle() records its phase.
+    finishPanelRefresh();
     display.powerDown();
 
     // Calculate sleep time
-    // REFRESH_MS is already in milliseconds
-    esp_sleep_enable_timer_wakeup(REFRESH_MS * 1000ULL);
-
-    // Enable Wakeup on button (GPIO 10)
-    // ESP32-S3 EXT1 wakeup
-    esp_sleep_enable_ext1_wakeup(1ULL << PIN_TOUCH, ESP_EXT1_WAKEUP_ANY_HIGH);
+    // REFRESH_MS is already in milliseconds, stretched by the battery policy.
+    // The watchface wakes on the next minute.
+    // After a failure the next attempt backs off instead.
+    // The request budget stretches it further while the API quota runs low.
+    uint64_t sleepMs = watchfaceMode() ? watchfaceSleepMs() : (uint64_t)budget.sleepMs(retry.sleepMs(power.refreshMs(REFRESH_MS)));
+    esp_sleep_enable_timer_wakeup(sleepMs * 1000ULL);
+
+    // Button gestures and the battery are watched by the ULP while asleep,
+    // it only wakes us for a decoded gesture or a low battery
+    if (!ulp.arm(batteryLowReported ? 0 : ULP_BATTERY_LOW_RAW))
+    {
+        // Fallback: plain wakeup on button (GPIO 10), ESP32-S3 EXT1 wakeup
+        esp_sleep_enable_ext1_wakeup(1ULL << PIN_TOUCH, ESP_EXT1_WAKEUP_ANY_HIGH);
+    }
 
     statusLed.setState(LED_OFF);
+    telemetry.endCycle();
 
     // Final delay to ensure Serial finishes / Display finishes
     delay(100);
@@ -208,6 +425,8 @@ void goToSleep()
 // --- LOOP ---
 void loop()
 {
+    pollButton();
+
     // Check for Config Mode Toggle
     if (shouldConfig)
     {
@@ -227,7 +446,19 @@ void loop()
     if (configMode)
     {
         ble.update();
-        delay(100);
+        statusLed.setState(ble.isActive() ? LED_CONFIG : LED_CONFIG_IDLE);
+
+        // An accidental long press must not keep BLE up until the battery is empty
+        if (CONFIG_TIMEOUT_MIN > 0 && ble.idleMs() > CONFIG_TIMEOUT_MIN * 60000UL)
+        {
+            // Nobody confirmed the writes with SAVE, so they are dropped
+            Serial.println("Config Mode idle -> Restarting without saving");
+            ble.stop();
+            ESP.restart();
+        }
+
+        // Blocks on the button queue, so the idle task can light-sleep between BLE events
+        pollButton(pdMS_TO_TICKS(1000));
         return; // Skip normal loop
     }
 
@@ -240,13 +471,13 @@ void loop()
         {
             Serial.println("Button Trigger -> Returning to SBB");
             currentPage = PAGE_SBB;
-            fetchSBB();
+            refreshContent(true);
             lastUpdate = millis();
         }
-        else
+        else if (manualRefreshAllowed())
         {
             Serial.println("Button Trigger -> Updating");
-            fetchSBB();
+            refreshContent(true);
             lastUpdate = millis();
         }
     }
@@ -259,8 +490,7 @@ void loop()
             Serial.println("Button Trigger -> Showing QR Page");
             currentPage = PAGE_QR;
             qrStartTime = millis();
-            drawQRCodePage();
-            display.display();
+            showStaticScreen(FRAME_SLOT_QR, drawQRCodePage);
         }
         else
         {
@@ -276,16 +506,21 @@ void loop()
             Serial.println("Returning to SBB and Sleeping");
             shouldUpdate = false;
             currentPage = PAGE_SBB;
-            fetchSBB();
+            refreshContent(true);
             goToSleep();
         }
-        delay(100);
+        pollButton(pdMS_TO_TICKS(100));
         return;
     }
 
-    // Default behavior for PAGE_SBB in loop:
+    // Default behavior for PAGE_SBB in loop: sleep unless a gesture is still in progress
     if (currentPage == PAGE_SBB)
     {
+        if (button.isHeld())
+        {
+            pollButton(pdMS_TO_TICKS(100));
+            return;
+        }
         goToSleep();
     }
 }
\ No newline at end of file
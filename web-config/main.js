@@ -8,8 +8,30 @@ const CHAR_STATION_UUID = "91bad492-b950-4226-aa2b-4ed124237673";
 const CHAR_REFRESH_UUID = "91bad492-b950-4226-aa2b-4ed124237674";
 const CHAR_ACTION_UUID = "91bad492-b950-4226-aa2b-4ed124237675";
 const CHAR_QR_ENABLE_UUID = "91bad492-b950-4226-aa2b-4ed124237676";
-const CHAR_QR_BITMAP_UUID = "91bad492-b950-4226-aa2b-4ed124237677";
-const CHAR_QR_SIZE_UUID = "91bad492-b950-4226-aa2b-4ed124237678";
+const CHAR_DIAG_UUID = "91bad492-b950-4226-aa2b-4ed124237679";
+const CHAR_BLOB_UUID = "91bad492-b950-4226-aa2b-4ed12423767a";
+const CHAR_MODE_UUID = "91bad492-b950-4226-aa2b-4ed12423767b";
+const CHAR_RENDER_URL_UUID = "91bad492-b950-4226-aa2b-4ed12423767c";
+const CHAR_CONFIG_TIMEOUT_UUID = "91bad492-b950-4226-aa2b-4ed12423767d";
+const CHAR_UPSTREAM_URL_UUID = "91bad492-b950-4226-aa2b-4ed12423767e";
+
+// Settings blob protocol, must match BleHandler.cpp
+const BLOB_VERSION = 1;
+const BLOB_FLAG_FIRST = 0x01;
+const BLOB_FLAG_LAST = 0x02;
+const BLOB_FLAG_SAVE = 0x04;
+const BLOB_TAG = { SSID: 1, PASS: 2, STATION: 3, REFRESH_MIN: 4, QR_ENABLED: 5, DISPLAY_MODE: 8, RENDER_URL: 9, CONFIG_TIMEOUT: 10, UPSTREAM_URL: 11 };
+const BLOB_STATUS = ["OK", "chunk out of order", "bad format", "invalid value"];
+
+// Must match TelemetryPhase / TelemetryError in Telemetry.h
+const DIAG_PHASES = [
+  { name: "WiFi", color: "#3498DB" },
+  { name: "Fetch", color: "#2ECC71" },
+  { name: "Render", color: "#F39C12" },
+  { name: "Refresh", color: "#D30000" },
+  { name: "DNS", color: "#9B59B6" },
+];
+const DIAG_ERRORS = ["None", "WiFi timeout", "HTTP error", "JSON error", "Panel busy timeout", "Bad frame", "WiFi auth rejected", "Rate limited"];
 
 let device = null;
 let server = null;
@@ -33,8 +55,18 @@ const wifiPassInput = document.getElementById('wifi-pass');
 const stationInput = document.getElementById('station-name');
 const refreshInput = document.getElementById('refresh-rate');
 const qrEnabledCheckbox = document.getElementById('qr-enabled');
+const displayModeSelect = document.getElementById('display-mode');
+const renderUrlInput = document.getElementById('render-url');
+const configTimeoutInput = document.getElementById('config-timeout');
+const upstreamUrlInput = document.getElementById('upstream-url');
 const qrPreviewContainer = document.getElementById('qr-preview-container');
 const qrCanvasHolder = document.getElementById('qr-canvas-holder');
+const qrPreviewHint = document.getElementById('qr-preview-hint');
+
+// Diagnostics
+const diagStats = document.getElementById('diag-stats');
+const diagChart = document.getElementById('diag-chart');
+const diagLegend = document.getElementById('diag-legend');
 
 // --- UTILS ---
 
@@ -66,6 +98,7 @@ async function connect() {
 
     // Initial Read
     await readAllSettings();
+    await startDiagnostics();
 
     // Switch View
     landingView.classList.remove('active');
@@ -92,17 +125,15 @@ async function readCharacteristic(uuid) {
   return new TextDecoder().decode(value);
 }
 
-async function writeCharacteristic(uuid, value) {
-  const char = await service.getCharacteristic(uuid);
-  const encoder = new TextEncoder();
-  await char.writeValue(encoder.encode(value));
-}
-
 async function readAllSettings() {
   try {
     wifiSsidInput.value = await readCharacteristic(CHAR_SSID_UUID);
     stationInput.value = await readCharacteristic(CHAR_STATION_UUID);
     refreshInput.value = await readCharacteristic(CHAR_REFRESH_UUID);
+    displayModeSelect.value = await readCharacteristic(CHAR_MODE_UUID);
+    renderUrlInput.value = await readCharacteristic(CHAR_RENDER_URL_UUID);
+    configTimeoutInput.value = await readCharacteristic(CHAR_CONFIG_TIMEOUT_UUID);
+    upstreamUrlInput.value = await readCharacteristic(CHAR_UPSTREAM_URL_UUID);
 
     const qrEnabledVal = await readCharacteristic(CHAR_QR_ENABLE_UUID);
     qrEnabledCheckbox.checked = (qrEnabledVal === "1");
@@ -112,47 +143,209 @@ async function readAllSettings() {
   }
 }
 
-async function writeSettings(reboot = false) {
-  const btn = reboot ? writeRebootBtn : writeBtn;
-  btn.classList.add('btn-loading');
-  btn.disabled = true;
+// --- DIAGNOSTICS ---
+
+// Decodes the little-endian snapshot built by Telemetry::serialize()
+function decodeDiagnostics(view) {
+  let o = 0;
+  const u8 = () => view.getUint8(o++);
+  const u16 = () => { const v = view.getUint16(o, true); o += 2; return v; };
+  const u32 = () => { const v = view.getUint32(o, true); o += 4; return v; };
+
+  const diag = {
+    version: u8(),
+    phaseCount: u8(),
+    recordCount: u8(),
+    lastError: u8(),
+    wakeCount: u32(),
+    uptimeMs: u32(),
+    freeHeap: u32(),
+    minFreeHeap: u32(),
+    maxAllocHeap: u32(),
+    freePsram: u32(),
+    records: []
+  };
+
+  for (let i = 0; i < diag.recordCount; i++) {
+    const rec = { totalMs: u32(), phaseMs: [] };
+    for (let p = 0; p < diag.phaseCount; p++) rec.phaseMs.push(u16());
+    rec.batteryMv = u16();
+    rec.wakeReason = u8();
+    rec.error = u8();
+    rec.radioMs = diag.version >= 2 ? u16() : 0;
+    diag.records.push(rec);
+  }
+  return diag;
+}
+
+function renderDiagnostics(diag) {
+  const kb = (b) => (b / 1024).toFixed(1) + " kB";
+  const latest = diag.records[0];
+  const stats = [
+    ["Wake cycles", diag.wakeCount],
+    ["Uptime", (diag.uptimeMs / 1000).toFixed(0) + " s"],
+    ["Free heap", kb(diag.freeHeap)],
+    ["Min free heap", kb(diag.minFreeHeap)],
+    ["Largest block", kb(diag.maxAllocHeap)],
+    ["Free PSRAM", kb(diag.freePsram)],
+    ["Radio on", latest && latest.radioMs ? (latest.radioMs / 1000).toFixed(1) + " s" : "n/a"],
+    ["Battery", latest && latest.batteryMv ? (latest.batteryMv / 1000).toFixed(2) + " V" : "n/a"],
+    ["Last error", DIAG_ERRORS[diag.lastError] || `#${diag.lastError}`],
+  ];
+  diagStats.innerHTML = stats.map(([k, v]) => `<dt>${k}</dt><dd>${v}</dd>`).join('');
+
+  // Stacked bars, oldest left
+  const ctx = diagChart.getContext('2d');
+  const { width, height } = diagChart;
+  ctx.clearRect(0, 0, width, height);
+
+  const records = diag.records.slice().reverse();
+  if (records.length === 0) return;
+
+  const maxMs = Math.max(...records.map(r => r.totalMs), 1);
+  const slot = width / records.length;
+  const barW = slot * 0.7;
+
+  records.forEach((rec, i) => {
+    const x = i * slot + (slot - barW) / 2;
+    let y = height;
+    rec.phaseMs.forEach((ms, p) => {
+      const h = (ms / maxMs) * (height - 14);
+      ctx.fillStyle = (DIAG_PHASES[p] || { color: "#888" }).color;
+      ctx.fillRect(x, y - h, barW, h);
+      y -= h;
+    });
+    // Total wake time outline (includes untracked time)
+    const totalH = (rec.totalMs / maxMs) * (height - 14);
+    ctx.strokeStyle = rec.error ? "#D30000" : "#444";
+    ctx.strokeRect(x, height - totalH, barW, totalH);
+    ctx.fillStyle = "#444";
+    ctx.font = "10px sans-serif";
+    ctx.fillText((rec.totalMs / 1000).toFixed(1) + "s", x, height - totalH - 3);
+  });
+}
+
+async function startDiagnostics() {
+  diagLegend.innerHTML = DIAG_PHASES
+    .map(p => `<span style="--swatch: ${p.color}">${p.name}</span>`).join('');
 
   try {
-    // 1. Write values
-    await writeCharacteristic(CHAR_SSID_UUID, wifiSsidInput.value);
+    const char = await service.getCharacteristic(CHAR_DIAG_UUID);
+    renderDiagnostics(decodeDiagnostics(await char.readValue()));
 
-    if (wifiPassInput.value) {
-      await writeCharacteristic(CHAR_PASS_UUID, wifiPassInput.value);
-    }
+    char.addEventListener('characteristicvaluechanged', (event) => {
+      renderDiagnostics(decodeDiagnostics(event.target.value));
+    });
+    await char.startNotifications();
+  } catch (e) {
+    console.warn("Diagnostics not available", e);
+  }
+}
 
-    await writeCharacteristic(CHAR_STATION_UUID, stationInput.value);
-    await writeCharacteristic(CHAR_REFRESH_UUID, refreshInput.value);
+// --- SETTINGS BLOB ---
 
-    // QR Logic
-    await writeCharacteristic(CHAR_QR_ENABLE_UUID, qrEnabledCheckbox.checked ? "1" : "0");
-    if (qrEnabledCheckbox.checked) {
-      const { bitmap, size } = generateQRBitmap();
-      await writeCharacteristic(CHAR_QR_SIZE_UUID, size.toString());
+const CRC_TABLE = (() => {
+  const table = new Uint32Array(256);
+  for (let n = 0; n < 256; n++) {
+    let c = n;
+    for (let k = 0; k < 8; k++) c = (c & 1) ? (0xEDB88320 ^ (c >>> 1)) : (c >>> 1);
+    table[n] = c >>> 0;
+  }
+  return table;
+})();
 
-      const qrChar = await service.getCharacteristic(CHAR_QR_BITMAP_UUID);
-      await qrChar.writeValue(bitmap);
-    }
+function crc32(bytes) {
+  let crc = 0xFFFFFFFF;
+  for (const b of bytes) crc = CRC_TABLE[(crc ^ b) & 0xFF] ^ (crc >>> 8);
+  return (crc ^ 0xFFFFFFFF) >>> 0;
+}
+
+// [version][tag, len, value]...
+function buildSettingsBlob() {
+  const encoder = new TextEncoder();
+  const fields = [];
+  const add = (tag, value) => {
+    if (value.length > 255) throw new Error(`Field ${tag} too long`);
+    fields.push(tag, value.length, ...value);
+  };
+
+  add(BLOB_TAG.SSID, encoder.encode(wifiSsidInput.value));
+  if (wifiPassInput.value) add(BLOB_TAG.PASS, encoder.encode(wifiPassInput.value));
+  add(BLOB_TAG.STATION, encoder.encode(stationInput.value));
+  const minutes = parseInt(refreshInput.value, 10) || 1;
+  add(BLOB_TAG.REFRESH_MIN, [minutes & 0xFF, (minutes >> 8) & 0xFF]);
+  // The display builds the QR code itself from the stored credentials
+  add(BLOB_TAG.QR_ENABLED, [qrEnabledCheckbox.checked ? 1 : 0]);
+  add(BLOB_TAG.DISPLAY_MODE, [parseInt(displayModeSelect.value, 10) || 0]);
+  add(BLOB_TAG.RENDER_URL, encoder.encode(renderUrlInput.value.trim()));
+  const timeout = Math.min(Math.max(parseInt(configTimeoutInput.value, 10) || 0, 0), 255);
+  add(BLOB_TAG.CONFIG_TIMEOUT, [timeout]);
+  add(BLOB_TAG.UPSTREAM_URL, encoder.encode(upstreamUrlInput.value.trim()));
+  return new Uint8Array([BLOB_VERSION, ...fields]);
+}
 
-    // 2. Verify (Read back)
-    showToast("Verifying settings...", "info");
-    const readSsid = await readCharacteristic(CHAR_SSID_UUID);
-    const readStation = await readCharacteristic(CHAR_STATION_UUID);
+// [u8 version][u8 status][u16 mtu][u32 crc]
+function decodeBlobStatus(view) {
+  return {
+    status: view.getUint8(1),
+    mtu: view.getUint16(2, true),
+    crc: view.getUint32(4, true)
+  };
+}
+
+async function writeSettingsBlob(blob, save) {
+  const char = await service.getCharacteristic(CHAR_BLOB_UUID);
+
+  // Chunk size follows the negotiated ATT MTU (3 bytes ATT + 3 bytes chunk header)
+  const { mtu } = decodeBlobStatus(await char.readValue());
+  const chunkSize = Math.max(1, Math.min(512, mtu - 3) - 3);
+
+  const result = new Promise((resolve, reject) => {
+    const timer = setTimeout(() => reject(new Error("No response from device")), 5000);
+    char.addEventListener('characteristicvaluechanged', (event) => {
+      clearTimeout(timer);
+      resolve(decodeBlobStatus(event.target.value));
+    }, { once: true });
+  });
+  await char.startNotifications();
+
+  for (let offset = 0; offset < blob.length || offset === 0; offset += chunkSize) {
+    const data = blob.subarray(offset, offset + chunkSize);
+    const last = offset + chunkSize >= blob.length;
+    let flags = 0;
+    if (offset === 0) flags |= BLOB_FLAG_FIRST;
+    if (last) flags |= BLOB_FLAG_LAST | (save ? BLOB_FLAG_SAVE : 0);
+
+    const chunk = new Uint8Array(3 + data.length);
+    chunk.set([flags, offset & 0xFF, offset >> 8]);
+    chunk.set(data, 3);
+    await char.writeValueWithResponse(chunk);
+    if (last) break;
+  }
 
-    if (readSsid === wifiSsidInput.value && readStation === stationInput.value) {
-      showToast("Settings verified and saved!", "success");
-    } else {
-      throw new Error("Verification failed. Values mismatch.");
+  return result;
+}
+
+async function writeSettings(reboot = false) {
+  const btn = reboot ? writeRebootBtn : writeBtn;
+  btn.classList.add('btn-loading');
+  btn.disabled = true;
+
+  try {
+    const blob = buildSettingsBlob();
+    const { status, crc } = await writeSettingsBlob(blob, reboot);
+
+    if (status !== 0) {
+      throw new Error("Device rejected settings: " + (BLOB_STATUS[status] || `#${status}`));
+    }
+    // The device echoes the CRC of what it applied
+    if (crc !== crc32(blob)) {
+      throw new Error("Verification failed. CRC mismatch.");
     }
+    showToast("Settings verified and saved!", "success");
 
-    // 3. Optional Reboot
     if (reboot) {
       showToast("Rebooting device...", "info");
-      await writeCharacteristic(CHAR_ACTION_UUID, "SAVE");
       // Device will disconnect automatically
     }
 
@@ -189,43 +382,30 @@ function updateQRPreview() {
   }
 }
 
-function renderQRToCanvas() {
-  const ssid = wifiSsidInput.value;
+// Same payload as wifiQrPayload() in SBB_Logic.h
+function wifiQrPayload() {
+  const escape = (v) => v.replace(/([\\;,":])/g, '\\$1');
+  const ssid = escape(wifiSsidInput.value);
   const pass = wifiPassInput.value;
-  const qrData = `WIFI:T:WPA;S:${ssid};P:${pass};;`;
-
-  // Use a version that fits (4 is usually good for typical WiFi)
-  // Low correction level 'L' to keep it small
-  const qr = qrcode(0, 'L');
-  qr.addData(qrData);
-  qr.make();
-  qrCanvasHolder.innerHTML = qr.createSvgTag(4, 8);
+  if (!pass) return `WIFI:T:nopass;S:${ssid};;`;
+  return `WIFI:T:WPA;S:${ssid};P:${escape(pass)};;`;
 }
 
-function generateQRBitmap() {
-  const ssid = wifiSsidInput.value;
-  const pass = wifiPassInput.value;
-  const qrData = `WIFI:T:WPA;S:${ssid};P:${pass};;`;
+function renderQRToCanvas() {
+  // The password cannot be read back and a blank field keeps the stored one,
+  // so without it there is nothing honest to preview
+  if (!wifiPassInput.value) {
+    qrCanvasHolder.innerHTML = '';
+    qrPreviewHint.textContent = 'Password left blank: the display keeps its stored password and encodes that. Type it to preview the code.';
+    return;
+  }
+  qrPreviewHint.textContent = 'The display generates this QR code from the WiFi credentials.';
 
+  // Preview only, the device encodes its own copy
   const qr = qrcode(0, 'L');
-  qr.addData(qrData);
+  qr.addData(wifiQrPayload());
   qr.make();
-
-  const moduleCount = qr.getModuleCount();
-  const bitmap = new Uint8Array(256).fill(0);
-
-  for (let y = 0; y < moduleCount; y++) {
-    for (let x = 0; x < moduleCount; x++) {
-      if (qr.isDark(y, x)) {
-        const bitIdx = y * moduleCount + x;
-        const byteIdx = Math.floor(bitIdx / 8);
-        const bitPos = 7 - (bitIdx % 8);
-        bitmap[byteIdx] |= (1 << bitPos);
-      }
-    }
-  }
-
-  return { bitmap, size: moduleCount };
+  qrCanvasHolder.innerHTML = qr.createSvgTag(4, 8);
 }
 
 qrEnabledCheckbox.addEventListener('change', updateQRPreview);
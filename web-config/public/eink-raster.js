@@ -0,0 +1,280 @@
+// 1-bpp tri-colour raster with the same integer primitives as Adafruit_GFX,
+// so designer previews and exported sprites match what the firmware draws.
+// Used by designer.html and tools/export-icons.js.
+
+// Same values as WeAct_EInk.h
+export const EINK_BLACK = 0x0000;
+export const EINK_WHITE = 0xFFFF;
+export const EINK_RED = 0xF800;
+
+const INK_NONE = 0;
+const INK_BLACK = 1;
+const INK_RED = 2;
+
+export class EInkRaster {
+  constructor(width, height) {
+    this.width = width;
+    this.height = height;
+    this.pixels = new Uint8Array(width * height);
+  }
+
+  clear() {
+    this.pixels.fill(INK_NONE);
+  }
+
+  drawPixel(x, y, color) {
+    x = Math.trunc(x);
+    y = Math.trunc(y);
+    if (x < 0 || y < 0 || x >= this.width || y >= this.height) return;
+    this.pixels[y * this.width + x] = color === EINK_BLACK ? INK_BLACK : color === EINK_RED ? INK_RED : INK_NONE;
+  }
+
+  drawFastVLine(x, y, h, color) {
+    for (let i = 0; i < h; i++) this.drawPixel(x, y + i, color);
+  }
+
+  drawFastHLine(x, y, w, color) {
+    for (let i = 0; i < w; i++) this.drawPixel(x + i, y, color);
+  }
+
+  // Bresenham, as Adafruit_GFX::writeLine
+  drawLine(x0, y0, x1, y1, color) {
+    [x0, y0, x1, y1] = [x0, y0, x1, y1].map(Math.trunc);
+    const steep = Math.abs(y1 - y0) > Math.abs(x1 - x0);
+    if (steep) [x0, y0, x1, y1] = [y0, x0, y1, x1];
+    if (x0 > x1) [x0, y0, x1, y1] = [x1, y1, x0, y0];
+
+    const dx = x1 - x0;
+    const dy = Math.abs(y1 - y0);
+    let err = Math.trunc(dx / 2);
+    const ystep = y0 < y1 ? 1 : -1;
+    for (; x0 <= x1; x0++) {
+      if (steep) this.drawPixel(y0, x0, color);
+      else this.drawPixel(x0, y0, color);
+      err -= dy;
+      if (err < 0) {
+        y0 += ystep;
+        err += dx;
+      }
+    }
+  }
+
+  drawRect(x, y, w, h, color) {
+    this.drawFastHLine(x, y, w, color);
+    this.drawFastHLine(x, y + h - 1, w, color);
+    this.drawFastVLine(x, y, h, color);
+    this.drawFastVLine(x + w - 1, y, h, color);
+  }
+
+  fillRect(x, y, w, h, color) {
+    for (let i = 0; i < h; i++) this.drawFastHLine(x, y + i, w, color);
+  }
+
+  drawCircle(x0, y0, r, color) {
+    [x0, y0, r] = [x0, y0, r].map(Math.trunc);
+    let f = 1 - r;
+    let ddFx = 1;
+    let ddFy = -2 * r;
+    let x = 0;
+    let y = r;
+    this.drawPixel(x0, y0 + r, color);
+    this.drawPixel(x0, y0 - r, color);
+    this.drawPixel(x0 + r, y0, color);
+    this.drawPixel(x0 - r, y0, color);
+    while (x < y) {
+      if (f >= 0) {
+        y--;
+        ddFy += 2;
+        f += ddFy;
+      }
+      x++;
+      ddFx += 2;
+      f += ddFx;
+      this.drawPixel(x0 + x, y0 + y, color);
+      this.drawPixel(x0 - x, y0 + y, color);
+      this.drawPixel(x0 + x, y0 - y, color);
+      this.drawPixel(x0 - x, y0 - y, color);
+      this.drawPixel(x0 + y, y0 + x, color);
+      this.drawPixel(x0 - y, y0 + x, color);
+      this.drawPixel(x0 + y, y0 - x, color);
+      this.drawPixel(x0 - y, y0 - x, color);
+    }
+  }
+
+  fillCircle(x0, y0, r, color) {
+    [x0, y0, r] = [x0, y0, r].map(Math.trunc);
+    this.drawFastVLine(x0, y0 - r, 2 * r + 1, color);
+    this.#fillCircleHelper(x0, y0, r, 3, 0, color);
+  }
+
+  #fillCircleHelper(x0, y0, r, corners, delta, color) {
+    let f = 1 - r;
+    let ddFx = 1;
+    let ddFy = -2 * r;
+    let x = 0;
+    let y = r;
+    let px = x;
+    let py = y;
+    delta++;
+    while (x < y) {
+      if (f >= 0) {
+        y--;
+        ddFy += 2;
+        f += ddFy;
+      }
+      x++;
+      ddFx += 2;
+      f += ddFx;
+      if (x < y + 1) {
+        if (corners & 1) this.drawFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+        if (corners & 2) this.drawFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+      }
+      if (y !== py) {
+        if (corners & 1) this.drawFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+        if (corners & 2) this.drawFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+        py = y;
+      }
+      px = x;
+    }
+  }
+
+  // Scanline fill, as Adafruit_GFX::fillTriangle
+  fillTriangle(x0, y0, x1, y1, x2, y2, color) {
+    [x0, y0, x1, y1, x2, y2] = [x0, y0, x1, y1, x2, y2].map(Math.trunc);
+    if (y0 > y1) [x0, y0, x1, y1] = [x1, y1, x0, y0];
+    if (y1 > y2) [x1, y1, x2, y2] = [x2, y2, x1, y1];
+    if (y0 > y1) [x0, y0, x1, y1] = [x1, y1, x0, y0];
+
+    if (y0 === y2) {
+      const a = Math.min(x0, x1, x2);
+      const b = Math.max(x0, x1, x2);
+      this.drawFastHLine(a, y0, b - a + 1, color);
+      return;
+    }
+
+    const dx01 = x1 - x0, dy01 = y1 - y0;
+    const dx02 = x2 - x0, dy02 = y2 - y0;
+    const dx12 = x2 - x1, dy12 = y2 - y1;
+    let sa = 0;
+    let sb = 0;
+    const last = y1 === y2 ? y1 : y1 - 1;
+    let y = y0;
+    for (; y <= last; y++) {
+      let a = x0 + Math.trunc(sa / dy01);
+      let b = x0 + Math.trunc(sb / dy02);
+      sa += dx01;
+      sb += dx02;
+      if (a > b) [a, b] = [b, a];
+      this.drawFastHLine(a, y, b - a + 1, color);
+    }
+    sa = dx12 * (y - y1);
+    sb = dx02 * (y - y0);
+    for (; y <= y2; y++) {
+      let a = x1 + Math.trunc(sa / dy12);
+      let b = x0 + Math.trunc(sb / dy02);
+      sa += dx12;
+      sb += dx02;
+      if (a > b) [a, b] = [b, a];
+      this.drawFastHLine(a, y, b - a + 1, color);
+    }
+  }
+
+  // Two 1-bpp masks, rows padded to whole bytes, MSB first, bit set = ink.
+  // Matches EInkSprite in WeAct_EInk.h.
+  pack() {
+    const rowBytes = Math.ceil(this.width / 8);
+    const black = new Uint8Array(rowBytes * this.height);
+    const red = new Uint8Array(rowBytes * this.height);
+    for (let y = 0; y < this.height; y++) {
+      for (let x = 0; x < this.width; x++) {
+        const ink = this.pixels[y * this.width + x];
+        const bit = 0x80 >> (x & 7);
+        const i = y * rowBytes + (x >> 3);
+        if (ink === INK_BLACK) black[i] |= bit;
+        else if (ink === INK_RED) red[i] |= bit;
+      }
+    }
+    return { rowBytes, black, red };
+  }
+
+  // Paint onto a 2D canvas context, `scale` canvas pixels per panel pixel
+  paint(ctx, scale = 1) {
+    ctx.fillStyle = '#ffffff';
+    ctx.fillRect(0, 0, this.width * scale, this.height * scale);
+    for (let y = 0; y < this.height; y++) {
+      for (let x = 0; x < this.width; x++) {
+        const ink = this.pixels[y * this.width + x];
+        if (ink === INK_NONE) continue;
+        ctx.fillStyle = ink === INK_BLACK ? '#000000' : '#eb0000';
+        ctx.fillRect(x * scale, y * scale, scale, scale);
+      }
+    }
+  }
+}
+
+// --- C header export ---
+
+function hexRows(bytes, perLine = 16) {
+  const lines = [];
+  for (let i = 0; i < bytes.length; i += perLine) {
+    lines.push('    ' + Array.from(bytes.slice(i, i + perLine), (b) => '0x' + b.toString(16).padStart(2, '0').toUpperCase()).join(', ') + ',');
+  }
+  return lines;
+}
+
+// icons: [{ name, codes, draw(raster) }], all `size` x `size`.
+// Returns the text of src/WeatherIcons.h
+export function exportWeatherIcons(icons, size, fallbackName) {
+  const out = [];
+  out.push('// Generated by web-config/tools/export-icons.js from web-config/public/weather-icons.js.');
+  out.push('// Do not edit, change the icons in the designer and re-export (npm run icons).');
+  out.push('#ifndef WEATHER_ICONS_H');
+  out.push('#define WEATHER_ICONS_H');
+  out.push('');
+  out.push('#include <Arduino.h>');
+  out.push('#include "WeAct_EInk.h"');
+  out.push('');
+
+  const entries = [];
+  for (const icon of icons) {
+    const raster = new EInkRaster(size, size);
+    icon.draw(raster);
+    const { black, red } = raster.pack();
+    const id = 'ICON_' + icon.name;
+    const planes = {};
+    out.push(`// ${icon.name}: WMO ${icon.codes.length ? icon.codes.join(', ') : '(fallback)'}`);
+    for (const [plane, bytes] of [['BLACK', black], ['RED', red]]) {
+      if (!bytes.some((b) => b)) {
+        planes[plane] = 'nullptr';
+        continue;
+      }
+      planes[plane] = `${id}_${plane}`;
+      out.push(`static const uint8_t ${id}_${plane}[] = {`);
+      out.push(...hexRows(bytes));
+      out.push('};');
+    }
+    out.push('');
+    entries.push(`    {${size}, ${size}, ${planes.BLACK}, ${planes.RED}}, // ${icon.name}`);
+  }
+
+  out.push('const EInkSprite WEATHER_ICONS[] = {');
+  out.push(...entries);
+  out.push('};');
+  out.push(`const int WEATHER_ICON_COUNT = ${icons.length};`);
+
+  const fallback = icons.findIndex((icon) => icon.name === fallbackName);
+  const byCode = new Array(100).fill(fallback);
+  icons.forEach((icon, index) => icon.codes.forEach((code) => (byCode[code] = index)));
+  out.push(`const uint8_t WEATHER_ICON_FALLBACK = ${fallback};`);
+  out.push('');
+  out.push('// WMO weather code (0-99) -> index into WEATHER_ICONS');
+  out.push('const uint8_t WEATHER_ICON_BY_CODE[100] = {');
+  for (let i = 0; i < 100; i += 20) {
+    out.push('    ' + byCode.slice(i, i + 20).join(', ') + ',');
+  }
+  out.push('};');
+  out.push('');
+  out.push('#endif');
+  out.push('');
+  return out.join('\r\n'); // Same line endings as the rest of src/
+}
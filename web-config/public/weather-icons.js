@@ -0,0 +1,168 @@
+// Weather icon set, one entry per WMO code group. Rendered with EInkRaster
+// and exported to src/WeatherIcons.h (designer "EXPORT ICONS" or npm run icons).
+import { EINK_BLACK, EINK_WHITE, EINK_RED } from './eink-raster.js';
+
+export const ICON_SIZE = 30;
+export const ICON_FALLBACK = 'CLOUD';
+
+const C = ICON_SIZE / 2;
+
+function sun(d, x, y, r, rays) {
+  d.fillCircle(x, y, r, EINK_RED);
+  for (let i = 0; i < rays; i++) {
+    const a = (i * 2 * Math.PI) / rays;
+    d.drawLine(x + (r + 2) * Math.cos(a), y + (r + 2) * Math.sin(a),
+      x + (r + 6) * Math.cos(a), y + (r + 6) * Math.sin(a), EINK_RED);
+  }
+}
+
+// Three-circle cloud, outlined (white inside) or solid
+function cloud(d, x, y, solid) {
+  const parts = [[-4, 2], [4, 2], [0, -2]];
+  for (const [dx, dy] of parts) {
+    if (solid) d.fillCircle(x + dx, y + dy, 6, EINK_BLACK);
+    else d.drawCircle(x + dx, y + dy, 6, EINK_BLACK);
+  }
+  if (!solid) for (const [dx, dy] of parts) d.fillCircle(x + dx, y + dy, 4, EINK_WHITE);
+  d.fillRect(x - 4, y + 2, 9, 6, solid ? EINK_BLACK : EINK_WHITE);
+  d.drawFastHLine(x - 4, y + 8, 9, EINK_BLACK);
+}
+
+function drops(d, x, y, count, len) {
+  for (let i = 0; i < count; i++) {
+    const dx = x + (i - (count - 1) / 2) * 5;
+    d.drawLine(dx + 2, y, dx + 2 - len / 2, y + len, EINK_RED);
+  }
+}
+
+function dots(d, x, y, count, color) {
+  for (let i = 0; i < count; i++) {
+    const dx = Math.round(x + (i - (count - 1) / 2) * 6);
+    d.fillRect(dx, y + (i % 2) * 3, 2, 2, color);
+  }
+}
+
+function flake(d, x, y, r) {
+  for (let i = 0; i < 6; i++) {
+    const a = (i * Math.PI) / 3;
+    d.drawLine(x, y, x + r * Math.cos(a), y + r * Math.sin(a), EINK_RED);
+    if (r < 8) continue;
+    // Side branches
+    const bx = x + (r * 2 / 3) * Math.cos(a);
+    const by = y + (r * 2 / 3) * Math.sin(a);
+    for (const s of [1, -1]) {
+      const b = a + (s * Math.PI) / 3;
+      d.drawLine(bx, by, bx + 4 * Math.cos(b), by + 4 * Math.sin(b), EINK_RED);
+    }
+  }
+}
+
+function bolt(d, x, y) {
+  d.fillTriangle(x + 2, y, x - 3, y + 7, x + 1, y + 7, EINK_RED);
+  d.fillTriangle(x + 1, y + 6, x - 2, y + 14, x + 4, y + 6, EINK_RED);
+}
+
+export const WEATHER_ICONS = [
+  {
+    name: 'CLEAR', codes: [0],
+    draw: (d) => sun(d, C, C, 8, 8),
+  },
+  {
+    name: 'MAINLY_CLEAR', codes: [1],
+    draw: (d) => {
+      sun(d, C - 2, C - 3, 7, 8);
+      cloud(d, C + 7, C + 6, false);
+    },
+  },
+  {
+    name: 'PARTLY_CLOUDY', codes: [2],
+    draw: (d) => {
+      d.fillCircle(C - 6, C - 5, 7, EINK_RED);
+      cloud(d, C + 2, C + 2, false);
+    },
+  },
+  {
+    name: 'OVERCAST', codes: [3],
+    draw: (d) => {
+      cloud(d, C + 4, C - 4, true);
+      cloud(d, C - 3, C + 3, false);
+    },
+  },
+  {
+    name: 'FOG', codes: [45, 48],
+    draw: (d) => {
+      d.drawCircle(C - 4, C - 5, 8, EINK_RED);
+      d.fillRect(C - 10, C - 3, 22, 2, EINK_BLACK);
+      d.fillRect(C - 13, C + 3, 22, 2, EINK_BLACK);
+      d.fillRect(C - 9, C + 9, 22, 2, EINK_BLACK);
+    },
+  },
+  {
+    name: 'DRIZZLE', codes: [51, 53, 55],
+    draw: (d) => {
+      cloud(d, C, C - 4, false);
+      dots(d, C, C + 8, 3, EINK_RED);
+    },
+  },
+  {
+    name: 'FREEZING_RAIN', codes: [56, 57, 66, 67],
+    draw: (d) => {
+      cloud(d, C, C - 5, true);
+      drops(d, C, C + 5, 3, 5);
+      d.fillRect(C - 9, C + 12, 19, 2, EINK_BLACK);
+    },
+  },
+  {
+    name: 'RAIN', codes: [61, 63, 65],
+    draw: (d) => {
+      cloud(d, C, C - 4, true);
+      drops(d, C, C + 6, 3, 8);
+    },
+  },
+  {
+    name: 'SNOW', codes: [71, 73, 75, 77],
+    draw: (d) => {
+      cloud(d, C + 3, C - 6, false);
+      flake(d, C - 4, C + 5, 9);
+    },
+  },
+  {
+    name: 'SHOWERS', codes: [80, 81, 82],
+    draw: (d) => {
+      sun(d, C - 6, C - 7, 5, 6);
+      cloud(d, C + 3, C - 1, true);
+      drops(d, C + 3, C + 9, 3, 5);
+    },
+  },
+  {
+    name: 'SNOW_SHOWERS', codes: [85, 86],
+    draw: (d) => {
+      sun(d, C - 6, C - 7, 5, 6);
+      cloud(d, C + 3, C - 1, false);
+      flake(d, C + 2, C + 10, 4);
+    },
+  },
+  {
+    name: 'THUNDER', codes: [95],
+    draw: (d) => {
+      cloud(d, C, C - 6, true);
+      bolt(d, C, C + 1);
+    },
+  },
+  {
+    name: 'THUNDER_HAIL', codes: [96, 99],
+    draw: (d) => {
+      cloud(d, C, C - 6, true);
+      bolt(d, C - 3, C + 1);
+      dots(d, C + 6, C + 8, 2, EINK_BLACK);
+    },
+  },
+  {
+    name: 'CLOUD', codes: [],
+    draw: (d) => {
+      d.fillCircle(C - 5, C + 3, 5, EINK_BLACK);
+      d.fillCircle(C + 5, C + 3, 5, EINK_BLACK);
+      d.fillCircle(C, C - 1, 7, EINK_BLACK);
+    },
+  },
+];
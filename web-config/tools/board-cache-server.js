@@ -0,0 +1,133 @@
+// Shared stationboard cache for a fleet of displays (Settings: Upstream URL).
+// Fetches each station from transport.opendata.ch (and its weather from
+// open-meteo) at most once per interval and serves the fixed-size binary
+// board decoded by readUpstreamBoard() in SBB_Logic.h.
+// Usage: npm run board-cache [-- port [intervalSeconds]]  ->  http://<host>:8081/board
+import { createServer } from 'node:http';
+
+const PORT = Number(process.argv[2] || process.env.PORT || 8081);
+const INTERVAL_MS = Number(process.argv[3] || process.env.INTERVAL || 60) * 1000;
+const WEATHER_INTERVAL_MS = 10 * 60 * 1000;
+const MAX_DEPARTURES = 8; // MAX_DEPARTURES in SBB_Logic.h
+
+// --- WIRE FORMAT (see SBB_Logic.h) ---
+const VERSION = 1;
+const HEADER_LEN = 16;
+const RECORD_LEN = 52;
+const FLAG_WEATHER = 0x01;
+
+// UTF-8, NUL padded, cut on a character boundary so one NUL always remains
+function putString(buf, offset, size, text) {
+  let bytes = Buffer.from(text || '', 'utf8');
+  let len = Math.min(bytes.length, size - 1);
+  while (len > 0 && (bytes[len] & 0xC0) === 0x80) len--;
+  bytes.copy(buf, offset, 0, len);
+}
+
+function encodeBoard(entry, limit) {
+  const departures = entry.departures.slice(0, limit);
+  const buf = Buffer.alloc(HEADER_LEN + departures.length * RECORD_LEN);
+  buf.write('SBRD', 0, 'ascii');
+  buf.writeUInt8(VERSION, 4);
+  buf.writeUInt8(departures.length, 5);
+  buf.writeUInt8(RECORD_LEN, 6);
+  buf.writeUInt8(entry.weather ? FLAG_WEATHER : 0, 7);
+  buf.writeUInt32LE(Math.floor(entry.fetchedAt / 1000), 8);
+  buf.writeInt16LE(entry.weather ? Math.round(entry.weather.temp * 10) : 0, 12);
+  buf.writeUInt8(entry.weather ? entry.weather.code : 0, 14);
+
+  departures.forEach((d, i) => {
+    const at = HEADER_LEN + i * RECORD_LEN;
+    putString(buf, at, 6, d.time);
+    buf.writeInt16LE(d.delay, at + 6);
+    putString(buf, at + 8, 12, d.line);
+    putString(buf, at + 20, 32, d.dest);
+  });
+  return buf;
+}
+
+// --- UPSTREAM ---
+async function fetchJson(url) {
+  const res = await fetch(url, { headers: { 'Accept-Encoding': 'gzip' } });
+  if (!res.ok) throw new Error(`${url} -> HTTP ${res.status}`);
+  return res.json();
+}
+
+async function fetchStation(station) {
+  const url = `https://transport.opendata.ch/v1/stationboard?station=${encodeURIComponent(station)}&limit=${MAX_DEPARTURES}`;
+  const doc = await fetchJson(url);
+  const departures = (doc.stationboard || []).map((conn) => {
+    const departure = (conn.stop && conn.stop.departure) || '';
+    return {
+      time: departure.length >= 16 ? departure.substring(11, 16) : '--:--',
+      delay: Math.max(-32768, Math.min(32767, Number(conn.stop && conn.stop.delay) || 0)),
+      line: `${conn.category || ''}${conn.number || ''}`,
+      dest: conn.to || '',
+    };
+  });
+  const coordinate = (doc.station && doc.station.coordinate) || {};
+  return { departures, lat: coordinate.x, lon: coordinate.y }; // SBB API x is lat
+}
+
+async function fetchWeather(lat, lon) {
+  const url = `http://api.open-meteo.com/v1/forecast?latitude=${lat.toFixed(4)}&longitude=${lon.toFixed(4)}&current_weather=true`;
+  const doc = await fetchJson(url);
+  return { temp: doc.current_weather.temperature, code: doc.current_weather.weathercode };
+}
+
+// --- CACHE ---
+// station -> { departures, weather, fetchedAt, weatherAt, pending }
+const cache = new Map();
+
+async function refresh(station, entry) {
+  const board = await fetchStation(station);
+  entry.departures = board.departures;
+  entry.fetchedAt = Date.now();
+  if (typeof board.lat === 'number' && typeof board.lon === 'number' && Date.now() - entry.weatherAt > WEATHER_INTERVAL_MS) {
+    try {
+      entry.weather = await fetchWeather(board.lat, board.lon);
+      entry.weatherAt = Date.now();
+    } catch (e) {
+      console.warn(`Weather for ${station}: ${e.message}`);
+    }
+  }
+  console.log(`${station}: ${entry.departures.length} departures fetched`);
+}
+
+// Concurrent requests for the same station share one upstream fetch
+async function board(station) {
+  const key = station.toLowerCase();
+  let entry = cache.get(key);
+  if (!entry) {
+    entry = { departures: [], weather: null, fetchedAt: 0, weatherAt: 0, pending: null };
+    cache.set(key, entry);
+  }
+  if (Date.now() - entry.fetchedAt >= INTERVAL_MS) {
+    entry.pending = entry.pending || refresh(station, entry).finally(() => { entry.pending = null; });
+    try {
+      await entry.pending;
+    } catch (e) {
+      console.warn(`${station}: ${e.message}`);
+      if (!entry.fetchedAt) throw e; // Nothing to fall back to
+    }
+  }
+  return entry; // Possibly stale, the display shows the fetch time
+}
+
+createServer(async (req, res) => {
+  const url = new URL(req.url, 'http://localhost');
+  const station = url.searchParams.get('station');
+  if (url.pathname !== '/board' || !station) {
+    res.writeHead(404).end();
+    return;
+  }
+  const limit = Math.min(Number(url.searchParams.get('limit')) || MAX_DEPARTURES, MAX_DEPARTURES);
+  try {
+    const body = encodeBoard(await board(station), limit);
+    res.writeHead(200, { 'Content-Type': 'application/octet-stream', 'Content-Length': body.length });
+    res.end(body);
+    console.log(`${req.socket.remoteAddress} ${station} ${body.length} bytes`);
+  } catch (e) {
+    res.writeHead(502).end();
+  }
+}).listen(PORT, () => console.log(`Board cache on :${PORT}/board, interval ${INTERVAL_MS / 1000}s`));
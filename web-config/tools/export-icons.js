@@ -0,0 +1,10 @@
+// Renders public/weather-icons.js and writes ../src/WeatherIcons.h
+// Usage: npm run icons
+import { writeFileSync } from 'node:fs';
+import { fileURLToPath } from 'node:url';
+import { exportWeatherIcons } from '../public/eink-raster.js';
+import { WEATHER_ICONS, ICON_SIZE, ICON_FALLBACK } from '../public/weather-icons.js';
+
+const target = fileURLToPath(new URL('../../src/WeatherIcons.h', import.meta.url));
+writeFileSync(target, exportWeatherIcons(WEATHER_ICONS, ICON_SIZE, ICON_FALLBACK));
+console.log(`Wrote ${WEATHER_ICONS.length} icons to ${target}`);
@@ -0,0 +1,76 @@
+// Frame encoding for the thin client, must match RenderClient.h / FrameCodec.h
+import { EInkRaster } from '../public/eink-raster.js';
+
+export const FRAME_VERSION = 1;
+export const FRAME_PACKBITS = 1;
+
+// PackBits, see FrameCodec.h
+export function packBits(data) {
+  const out = [];
+  let i = 0;
+  while (i < data.length) {
+    let run = 1;
+    while (i + run < data.length && run < 128 && data[i + run] === data[i]) run++;
+    if (run >= 2) {
+      out.push(257 - run, data[i]);
+      i += run;
+      continue;
+    }
+    // Literals until the next run of 3+ (a run of 2 is not worth breaking for)
+    const start = i;
+    while (i < data.length && i - start < 128) {
+      if (i + 2 < data.length && data[i] === data[i + 1] && data[i] === data[i + 2]) break;
+      i++;
+    }
+    out.push(i - start - 1, ...data.subarray(start, i));
+  }
+  return Uint8Array.from(out);
+}
+
+const CRC_TABLE = new Uint32Array(256).map((_, n) => {
+  let c = n;
+  for (let k = 0; k < 8; k++) c = c & 1 ? 0xEDB88320 ^ (c >>> 1) : c >>> 1;
+  return c;
+});
+
+// Standard CRC32, same as esp_rom_crc32_le(0, ...) on the device
+export function crc32(...chunks) {
+  let crc = 0xFFFFFFFF;
+  for (const chunk of chunks) {
+    for (const b of chunk) crc = CRC_TABLE[(crc ^ b) & 0xFF] ^ (crc >>> 8);
+  }
+  return (crc ^ 0xFFFFFFFF) >>> 0;
+}
+
+// Raster -> driver planes (black: 0 = ink, red: 1 = ink, red pixels are white in the black plane)
+export function framePlanes(raster) {
+  const { black, red } = raster.pack();
+  return { black: black.map((b) => ~b & 0xFF), red };
+}
+
+// Full response body: 24 byte FrameHeader + PackBits planes
+export function encodeFrame(raster) {
+  const planes = framePlanes(raster);
+  const hash = crc32(planes.black, planes.red);
+  const black = packBits(planes.black);
+  const red = packBits(planes.red);
+
+  const header = new DataView(new ArrayBuffer(24));
+  [...'EFRM'].forEach((c, i) => header.setUint8(i, c.charCodeAt(0)));
+  header.setUint8(4, FRAME_VERSION);
+  header.setUint8(5, FRAME_PACKBITS);
+  header.setUint16(6, raster.width, true);
+  header.setUint16(8, raster.height, true);
+  header.setUint16(10, 0, true);
+  header.setUint32(12, hash, true);
+  header.setUint32(16, black.length, true);
+  header.setUint32(20, red.length, true);
+
+  const body = new Uint8Array(24 + black.length + red.length);
+  body.set(new Uint8Array(header.buffer), 0);
+  body.set(black, 24);
+  body.set(red, 24 + black.length);
+  return { body, hash };
+}
+
+export { EInkRaster };
@@ -0,0 +1,116 @@
+// Minimal render service for testing thin-client mode (Settings: Render URL).
+// Draws a synthetic departure board, no SBB access needed.
+// Usage: npm run mock-render [-- port]   ->  http://<host>:8080/frame
+import { createServer } from 'node:http';
+import { EInkRaster, EINK_BLACK, EINK_RED } from '../public/eink-raster.js';
+import { WEATHER_ICONS, ICON_SIZE } from '../public/weather-icons.js';
+import { encodeFrame } from './frame.js';
+
+const PORT = Number(process.argv[2] || process.env.PORT || 8080);
+const WIDTH = 400;
+const HEIGHT = 300;
+
+// --- 3x5 FONT (scaled up when drawn) ---
+const GLYPHS = {
+  A: '010101111101101', B: '110101110101110', C: '011100100100011', D: '110101101101110',
+  E: '111100110100111', F: '111100110100100', G: '011100101101011', H: '101101111101101',
+  I: '111010010010111', J: '001001001101010', K: '101101110101101', L: '100100100100111',
+  M: '101111111101101', N: '110101101101101', O: '010101101101010', P: '110101110100100',
+  Q: '010101101110011', R: '110101110101101', S: '011100010001110', T: '111010010010010',
+  U: '101101101101111', V: '101101101101010', W: '101101111111101', X: '101101010101101',
+  Y: '101101010010010', Z: '111001010100111',
+  0: '111101101101111', 1: '010110010010111', 2: '110001010100111', 3: '110001010001110',
+  4: '101101111001001', 5: '111100110001110', 6: '011100111101111', 7: '111001010010010',
+  8: '111101111101111', 9: '111101111001110',
+  ':': '000010000010000', '+': '000010111010000', '-': '000000111000000',
+  '.': '000000000000010', "'": '010010000000000', '/': '001001010100100',
+};
+
+function drawText(r, x, y, text, color, scale = 2) {
+  for (const ch of text.toUpperCase()) {
+    const glyph = GLYPHS[ch];
+    if (glyph) {
+      for (let i = 0; i < 15; i++) {
+        if (glyph[i] === '1') r.fillRect(x + (i % 3) * scale, y + Math.floor(i / 3) * scale, scale, scale, color);
+      }
+    }
+    x += 4 * scale;
+  }
+}
+
+// Copies the inked pixels of a weather icon onto the board
+function drawIcon(r, x, y, name) {
+  const icon = WEATHER_ICONS.find((i) => i.name === name) || WEATHER_ICONS[0];
+  const sprite = new EInkRaster(ICON_SIZE, ICON_SIZE);
+  icon.draw(sprite);
+  for (let sy = 0; sy < ICON_SIZE; sy++) {
+    for (let sx = 0; sx < ICON_SIZE; sx++) {
+      const ink = sprite.pixels[sy * ICON_SIZE + sx];
+      if (ink) r.pixels[(y + sy) * WIDTH + x + sx] = ink;
+    }
+  }
+}
+
+// --- SYNTHETIC BOARD ---
+const LINES = [['IC', '5', 'ZUERICH HB'], ['S', '3', 'BIEL'], ['IR', '15', 'LUZERN'], ['RE', '', 'OLTEN']];
+
+// Content only changes when a departure leaves, so the ETag stays stable in between
+function departures(now, count) {
+  const interval = 7;
+  const minute = Math.floor(now / 60000);
+  const first = Math.ceil(minute / interval) * interval;
+  const out = [];
+  for (let i = 0; i < count; i++) {
+    const slot = first + i * interval;
+    const [category, number, destination] = LINES[(slot / interval) % LINES.length];
+    const at = new Date(slot * 60000);
+    out.push({
+      category, number, destination,
+      time: `${String(at.getHours()).padStart(2, '0')}:${String(at.getMinutes()).padStart(2, '0')}`,
+      delay: slot % 5 === 0 ? 2 : 0,
+      platform: String(1 + (slot % 6)),
+    });
+  }
+  return out;
+}
+
+function renderBoard(station, limit) {
+  const r = new EInkRaster(WIDTH, HEIGHT);
+  r.fillRect(0, 0, WIDTH, 40, EINK_RED);
+  drawText(r, 10, 12, station, 0xFFFF, 3);
+  drawIcon(r, WIDTH - ICON_SIZE - 6, 5, 'PARTLY_CLOUDY');
+
+  let y = 52;
+  for (const d of departures(Date.now(), limit)) {
+    r.drawRect(10, y, 46, 22, EINK_BLACK);
+    drawText(r, 14, y + 6, `${d.category}${d.number}`, EINK_BLACK);
+    drawText(r, 66, y + 6, d.time, EINK_BLACK);
+    if (d.delay) drawText(r, 110, y + 6, `+${d.delay}`, EINK_RED);
+    drawText(r, 140, y + 6, d.destination, EINK_BLACK);
+    drawText(r, WIDTH - 30, y + 6, d.platform, EINK_BLACK);
+    r.drawFastHLine(10, y + 29, WIDTH - 20, EINK_BLACK);
+    y += 36;
+  }
+  return r;
+}
+
+createServer((req, res) => {
+  const url = new URL(req.url, 'http://localhost');
+  if (url.pathname !== '/frame') {
+    res.writeHead(404).end();
+    return;
+  }
+  const station = url.searchParams.get('station') || 'BERN';
+  const limit = Math.min(Number(url.searchParams.get('limit')) || 6, 6);
+  const { body, hash } = encodeFrame(renderBoard(station, limit));
+  const etag = `"${hash.toString(16).padStart(8, '0')}"`;
+
+  if (req.headers['if-none-match'] === etag) {
+    res.writeHead(304, { ETag: etag }).end();
+    console.log(`${req.socket.remoteAddress} 304 ${etag}`);
+    return;
+  }
+  res.writeHead(200, { 'Content-Type': 'application/octet-stream', 'Content-Length': body.length, ETag: etag });
+  res.end(body);
+  console.log(`${req.socket.remoteAddress} 200 ${etag} ${body.length} bytes`);
+}).listen(PORT, () => console.log(`Render service on :${PORT}/frame`));